@@ -0,0 +1,284 @@
+#ifndef ESSENTIALS_CI_STRING_VIEW_HPP
+#define ESSENTIALS_CI_STRING_VIEW_HPP
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+/*
+ * ASCII case-insensitive character traits: 'A'-'Z' compare equal to 'a'-'z',
+ * every other byte (UTF-8 included) compares as itself.
+ * Ordering is that of the lowercased bytes, taken unsigned like std::char_traits<char>.
+ */
+struct ci_char_traits: std::char_traits<char> {
+    static constexpr char fold(char c) noexcept {
+        return (c >= 'A' && c <= 'Z')? char(c + ('a' - 'A')) : c;
+    }
+    static constexpr bool eq(char lhv, char rhv) noexcept {
+        return fold(lhv) == fold(rhv);
+    }
+    static constexpr bool lt(char lhv, char rhv) noexcept {
+        return static_cast<unsigned char>(fold(lhv)) < static_cast<unsigned char>(fold(rhv));
+    }
+
+    static int compare(const char* lhv, const char* rhv, size_t size) noexcept {
+        size_t ix = 0;
+#ifdef ESSENTIALS_SIMD_X86
+        ix = detail::cpu::has_avx2()? compare_avx2(lhv, rhv, size) : compare_sse2(lhv, rhv, size);
+#endif
+        for(; ix < size; ++ix)
+            if(!eq(lhv[ix], rhv[ix])) return lt(lhv[ix], rhv[ix])? -1 : 1;
+        return 0;
+    }
+
+    static const char* find(const char* s, size_t size, char c) noexcept {
+        auto lower = fold(c);
+        if(lower < 'a' || lower > 'z') return static_cast<const char*>(std::memchr(s, c, size));
+        size_t ix = 0;
+#ifdef ESSENTIALS_SIMD_X86
+        ix = detail::cpu::has_avx2()? find_avx2(s, size, lower) : find_sse2(s, size, lower);
+#endif
+        for(; ix < size; ++ix)
+            if(fold(s[ix]) == lower) return s + ix;
+        return nullptr;
+    }
+
+#ifdef ESSENTIALS_SIMD_X86
+    // 'A'-'Z' land on [-128, -103] once shifted by 0x80 - 'A', the only bytes below -102
+    static __m128i fold16(__m128i x) noexcept {
+        auto shifted = _mm_add_epi8(x, _mm_set1_epi8(char(0x80 - 'A')));
+        auto upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(char(-128 + 26)));
+        return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+    }
+
+    __attribute__((target("avx2")))
+    static __m256i fold32(__m256i x) noexcept {
+        auto shifted = _mm256_add_epi8(x, _mm256_set1_epi8(char(0x80 - 'A')));
+        auto upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(char(-128 + 26)), shifted);
+        return _mm256_or_si256(x, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+    }
+
+private:
+    // these return how far they got: the first mismatch or match is at or after that index
+    static size_t compare_sse2(const char* lhv, const char* rhv, size_t size) noexcept {
+        size_t ix = 0;
+        for(; ix + 16 <= size; ix += 16) {
+            auto l = fold16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lhv + ix)));
+            auto r = fold16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rhv + ix)));
+            auto mask = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(l, r)));
+            if(mask != 0xFFFF) return ix + size_t(__builtin_ctz(~mask));
+        }
+        return ix;
+    }
+
+    __attribute__((target("avx2")))
+    static size_t compare_avx2(const char* lhv, const char* rhv, size_t size) noexcept {
+        size_t ix = 0;
+        for(; ix + 32 <= size; ix += 32) {
+            auto l = fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhv + ix)));
+            auto r = fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhv + ix)));
+            auto mask = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(l, r)));
+            if(mask != 0xFFFFFFFFu) return ix + size_t(__builtin_ctz(~mask));
+        }
+        return ix + compare_sse2(lhv + ix, rhv + ix, size - ix);
+    }
+
+    static size_t find_sse2(const char* s, size_t size, char lower) noexcept {
+        const __m128i pattern = _mm_set1_epi8(lower);
+        size_t ix = 0;
+        for(; ix + 16 <= size; ix += 16) {
+            auto block = fold16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + ix)));
+            auto mask = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+            if(mask != 0) return ix + size_t(__builtin_ctz(mask));
+        }
+        return ix;
+    }
+
+    __attribute__((target("avx2")))
+    static size_t find_avx2(const char* s, size_t size, char lower) noexcept {
+        const __m256i pattern = _mm256_set1_epi8(lower);
+        size_t ix = 0;
+        for(; ix + 32 <= size; ix += 32) {
+            auto block = fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + ix)));
+            auto mask = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+            if(mask != 0) return ix + size_t(__builtin_ctz(mask));
+        }
+        return ix + find_sse2(s + ix, size - ix, lower);
+    }
+#endif
+};
+
+namespace detail {
+
+template<>
+struct fast_char_set<char, ci_char_traits>: std::true_type {};
+
+#ifdef ESSENTIALS_SIMD_X86
+// the anchor prefilter of kernels<char> over case-folded blocks
+template<>
+struct kernels<char, ci_char_traits>: scalar_kernels<char, ci_char_traits> {
+    using traits = ci_char_traits;
+
+    static size_t anchor(const char* needle, size_t m) noexcept {
+        auto ix = m - 1;
+        while(ix > 1 && traits::eq(needle[ix], needle[0])) --ix;
+        return ix;
+    }
+
+    static const char* find_tail(const char* hay, size_t n, const char* needle, size_t m, size_t i) noexcept {
+        for(; i + m <= n; ++i)
+            if(traits::eq(hay[i], needle[0])) {
+                if(traits::compare(hay + i + 1, needle + 1, m - 1) == 0) return hay + i;
+                ESSENTIALS_HOOK(count_mismatch(view_op::find));
+            }
+        return nullptr;
+    }
+
+    static const char* find_sse2(const char* hay, size_t n, const char* needle, size_t m) noexcept {
+        auto k = anchor(needle, m);
+        const __m128i first = _mm_set1_epi8(traits::fold(needle[0]));
+        const __m128i second = _mm_set1_epi8(traits::fold(needle[k]));
+        size_t i = 0;
+        for(; i + m + 15 <= n; i += 16) {
+            auto bf = traits::fold16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i)));
+            auto bs = traits::fold16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + k)));
+            auto mask = unsigned(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(second, bs))));
+            while(mask != 0) {
+                auto bit = size_t(__builtin_ctz(mask));
+                if(traits::compare(hay + i + bit + 1, needle + 1, m - 1) == 0) return hay + i + bit;
+                ESSENTIALS_HOOK(count_mismatch(view_op::find));
+                mask &= mask - 1;
+            }
+        }
+        return find_tail(hay, n, needle, m, i);
+    }
+
+    __attribute__((target("avx2")))
+    static const char* find_avx2(const char* hay, size_t n, const char* needle, size_t m) noexcept {
+        auto k = anchor(needle, m);
+        const __m256i first = _mm256_set1_epi8(traits::fold(needle[0]));
+        const __m256i second = _mm256_set1_epi8(traits::fold(needle[k]));
+        size_t i = 0;
+        for(; i + m + 31 <= n; i += 32) {
+            auto bf = traits::fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i)));
+            auto bs = traits::fold32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i + k)));
+            auto mask = unsigned(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(second, bs))));
+            while(mask != 0) {
+                auto bit = size_t(__builtin_ctz(mask));
+                if(traits::compare(hay + i + bit + 1, needle + 1, m - 1) == 0) return hay + i + bit;
+                ESSENTIALS_HOOK(count_mismatch(view_op::find));
+                mask &= mask - 1;
+            }
+        }
+        return find_sse2(hay + i, n - i, needle, m);
+    }
+
+    static const char* find(const char* hay, size_t n, const char* needle, size_t m) noexcept {
+        if(m == 1) {
+            ESSENTIALS_HOOK(count_kernel(view_op::find, view_kernel::library));
+            return traits::find(hay, n, *needle);
+        }
+        if(m > two_way_threshold) {
+            ESSENTIALS_HOOK(count_kernel(view_op::find, view_kernel::two_way));
+            return two_way<char, traits>(needle, m).find(hay, n);
+        }
+        if(cpu::has_avx2()) {
+            ESSENTIALS_HOOK(count_kernel(view_op::find, view_kernel::avx2));
+            return find_avx2(hay, n, needle, m);
+        }
+        ESSENTIALS_HOOK(count_kernel(view_op::find, view_kernel::sse2));
+        return find_sse2(hay, n, needle, m);
+    }
+};
+#endif
+
+// lowercases the ASCII letters of 8 bytes at once
+constexpr uint64_t fold_word(uint64_t x) noexcept {
+    constexpr uint64_t ones = 0x0101010101010101ULL;
+    constexpr uint64_t highs = 0x8080808080808080ULL;
+    auto heptets = x & ~highs;
+    auto ge_a = heptets + (0x80 - 'A') * ones;
+    auto gt_z = heptets + (0x80 - 'Z' - 1) * ones;
+    return x | (((ge_a ^ gt_z) & ~x & highs) >> 2);
+}
+
+// byte_reader over the lowercased bytes, for hashing case-insensitive views
+class folding_reader {
+    byte_reader<char> bytes_;
+
+public:
+    constexpr explicit folding_reader(const char* data) noexcept: bytes_(data) {}
+
+    constexpr uint64_t byte(size_t off) const noexcept { return fold_word(bytes_.byte(off)); }
+    constexpr uint64_t r4(size_t off) const noexcept { return fold_word(bytes_.r4(off)); }
+    constexpr uint64_t r8(size_t off) const noexcept { return fold_word(bytes_.r8(off)); }
+};
+
+} /* namespace detail */
+
+// the plain byte set with both cases of every letter
+template<>
+class basic_char_set<char, ci_char_traits, true>: public basic_char_set<char, std::char_traits<char>, true> {
+public:
+    basic_char_set() noexcept = default;
+    basic_char_set(const char* s, size_t size) noexcept {
+        for(size_t ix = 0; ix < size; ++ix) {
+            auto lower = ci_char_traits::fold(s[ix]);
+            insert_byte(static_cast<unsigned char>(s[ix]));
+            insert_byte(static_cast<unsigned char>(lower));
+            if(lower >= 'a' && lower <= 'z') insert_byte(static_cast<unsigned char>(lower - ('a' - 'A')));
+        }
+    }
+    basic_char_set(basic_string_view<char, ci_char_traits> v) noexcept: basic_char_set(v.data(), v.size()) {}
+    basic_char_set(const char* s) noexcept: basic_char_set(s, std::strlen(s)) {}
+};
+
+// wyhash over the lowercased bytes: equal ci views hash the same
+struct ci_hash_policy {
+    static constexpr uint64_t hash(const char* data, size_t size, uint64_t seed) noexcept {
+        return wyhash_policy::hash_bytes(detail::folding_reader(data), size, seed);
+    }
+};
+
+using ci_string_view = basic_string_view<char, ci_char_traits>;
+using ci_char_set = basic_char_set<char, ci_char_traits>;
+using ci_string_view_hash = basic_string_view_hash<char, ci_char_traits, ci_hash_policy>;
+
+constexpr ci_string_view operator"" _ci(const char* s, size_t len) { return ci_string_view(s, len); }
+
+// the same characters, seen case-insensitively; nothing is copied
+constexpr ci_string_view as_ci(basic_string_view<char> v) noexcept {
+    return ci_string_view(v.data(), v.size());
+}
+
+/*
+ * Mixed comparisons against plain views are case-insensitive.
+ * The plain side is a deduced template parameter, so literals keep going to the ci-only operators.
+ */
+# define CI_COMPARE_OP(OPC) \
+    template<class Traits, class = typename std::enable_if<std::is_same<Traits, std::char_traits<char>>::value>::type> \
+    constexpr bool operator OPC(ci_string_view lhv, basic_string_view<char, Traits> rhv) noexcept { \
+        return lhv OPC as_ci(rhv); \
+    } \
+    template<class Traits, class = typename std::enable_if<std::is_same<Traits, std::char_traits<char>>::value>::type> \
+    constexpr bool operator OPC(basic_string_view<char, Traits> lhv, ci_string_view rhv) noexcept { \
+        return as_ci(lhv) OPC rhv; \
+    }
+
+CI_COMPARE_OP(==)
+CI_COMPARE_OP(!=)
+CI_COMPARE_OP(<)
+CI_COMPARE_OP(<=)
+CI_COMPARE_OP(>)
+CI_COMPARE_OP(>=)
+
+# undef CI_COMPARE_OP
+
+} /* namespace essentials */
+
+namespace std {
+    template<>
+    struct hash<essentials::ci_string_view>: essentials::ci_string_view_hash {};
+} /* namespace std */
+
+#endif /* ESSENTIALS_CI_STRING_VIEW_HPP */
@@ -0,0 +1,248 @@
+#ifndef ESSENTIALS_CSV_SCANNER_HPP
+#define ESSENTIALS_CSV_SCANNER_HPP
+
+#include <string>
+#include <vector>
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+struct csv_dialect {
+    char delimiter = ',';
+    char quote = '"';
+    // "\r\n" ends a record as well as "\n"
+    bool crlf = true;
+};
+
+/*
+ * A field as it is in the input. Quoted fields keep their doubled quotes until unescape is asked for,
+ * so fields nobody looks at cost nothing.
+ */
+class csv_field {
+    string_view raw_;
+    char quote_ = '"';
+
+public:
+    csv_field() noexcept = default;
+    csv_field(string_view raw, char quote) noexcept: raw_(raw), quote_(quote) {}
+
+    string_view raw() const noexcept { return raw_; }
+    bool quoted() const noexcept { return !raw_.empty() && raw_.front() == quote_; }
+
+    // the field without its enclosing quotes, doubled quotes left in place
+    string_view value() const noexcept {
+        if(!quoted()) return raw_;
+        auto end = (raw_.size() >= 2 && raw_.back() == quote_)? raw_.size() - 1 : raw_.size();
+        return raw_.substr(1, end - 1);
+    }
+    // whether value() still has doubled quotes in it
+    bool escaped() const noexcept { return quoted() && value().find(quote_) != string_view::npos; }
+
+    // value() with doubled quotes undone, put into `buffer` only if there were any
+    string_view unescape(std::string& buffer) const {
+        auto v = value();
+        if(!escaped()) return v;
+        buffer.clear();
+        for(size_t ix = 0; ix < v.size(); ++ix) {
+            buffer.push_back(v[ix]);
+            if(v[ix] == quote_ && ix + 1 < v.size() && v[ix + 1] == quote_) ++ix;
+        }
+        return buffer;
+    }
+    std::string str() const {
+        std::string buffer;
+        auto v = unescape(buffer);
+        return (v.data() == buffer.data())? buffer : std::string(v);
+    }
+};
+
+// the fields of one record, valid until the scanner moves on
+class csv_record {
+    const csv_field* first_ = nullptr;
+    const csv_field* last_ = nullptr;
+
+public:
+    csv_record() noexcept = default;
+    csv_record(const csv_field* first, const csv_field* last) noexcept: first_(first), last_(last) {}
+
+    const csv_field* begin() const noexcept { return first_; }
+    const csv_field* end() const noexcept { return last_; }
+    size_t size() const noexcept { return size_t(last_ - first_); }
+    bool empty() const noexcept { return first_ == last_; }
+    const csv_field& operator[](size_t ix) const noexcept { return first_[ix]; }
+};
+
+namespace detail {
+
+// one bit per byte of a 64-byte block
+struct csv_masks {
+    uint64_t quote;
+    uint64_t structural;
+};
+
+// bit i becomes the xor of bits 0..i: set from an opening quote up to the closing one
+inline uint64_t prefix_xor(uint64_t bits) noexcept {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+inline csv_masks csv_classify_scalar(const char* p, char delimiter, char quote) noexcept {
+    csv_masks res{ 0, 0 };
+    for(unsigned ix = 0; ix < 64; ++ix) {
+        res.quote |= uint64_t(p[ix] == quote) << ix;
+        res.structural |= uint64_t(p[ix] == delimiter || p[ix] == '\n') << ix;
+    }
+    return res;
+}
+
+#ifdef ESSENTIALS_SIMD_X86
+__attribute__((target("pclmul")))
+inline uint64_t prefix_xor_clmul(uint64_t bits) noexcept {
+    // a carry-less multiply by all ones is the running xor
+    auto product = _mm_clmulepi64_si128(_mm_set_epi64x(0, int64_t(bits)), _mm_set1_epi8(-1), 0);
+    // in 32-bit halves: _mm_cvtsi128_si64 is x86-64 only
+    return uint64_t(uint32_t(_mm_cvtsi128_si32(product)))
+        | uint64_t(uint32_t(_mm_cvtsi128_si32(_mm_srli_si128(product, 4)))) << 32;
+}
+
+inline uint64_t eq_mask_sse2(const __m128i (&blocks)[4], __m128i pattern) noexcept {
+    uint64_t res = 0;
+    for(unsigned ix = 0; ix < 4; ++ix)
+        res |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(blocks[ix], pattern)))) << (16 * ix);
+    return res;
+}
+
+inline csv_masks csv_classify_sse2(const char* p, char delimiter, char quote) noexcept {
+    __m128i blocks[4];
+    for(unsigned ix = 0; ix < 4; ++ix) blocks[ix] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * ix));
+    return csv_masks{
+        eq_mask_sse2(blocks, _mm_set1_epi8(quote)),
+        eq_mask_sse2(blocks, _mm_set1_epi8(delimiter)) | eq_mask_sse2(blocks, _mm_set1_epi8('\n'))
+    };
+}
+
+__attribute__((target("avx2")))
+inline uint64_t eq_mask_avx2(__m256i lo, __m256i hi, __m256i pattern) noexcept {
+    auto low = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, pattern)));
+    auto high = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, pattern)));
+    return uint64_t(low) | uint64_t(high) << 32;
+}
+
+__attribute__((target("avx2")))
+inline csv_masks csv_classify_avx2(const char* p, char delimiter, char quote) noexcept {
+    auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    return csv_masks{
+        eq_mask_avx2(lo, hi, _mm256_set1_epi8(quote)),
+        eq_mask_avx2(lo, hi, _mm256_set1_epi8(delimiter)) | eq_mask_avx2(lo, hi, _mm256_set1_epi8('\n'))
+    };
+}
+#endif
+
+} /* namespace detail */
+
+/*
+ * Splits delimited text into records of fields without copying it.
+ * The input is classified 64 bytes at a time: one SIMD compare per character class gives bitmasks
+ * of quotes, delimiters and newlines; the running xor of the quote bits (a carry-less multiply)
+ * marks what is inside quotes, and what is left of the delimiters and newlines are the field ends.
+ * Doubled quotes toggle the state twice, so they need no special casing.
+ * A lone '\r' is not a line break; an unterminated quote runs to the end of the input.
+ * The input (a view, or a mapped_file) has to outlive the scanner and the fields it yields.
+ */
+class csv_scanner {
+    string_view data_;
+    csv_dialect dialect_;
+    std::vector<csv_field> fields_;
+    size_t field_start_ = 0;
+    // field ends left in the block at block_, and how far blocks were classified
+    uint64_t bits_ = 0;
+    size_t block_ = 0;
+    size_t scanned_ = 0;
+    // all ones when the last classified byte was inside quotes
+    uint64_t in_quotes_ = 0;
+
+    detail::csv_masks classify(const char* p) const noexcept {
+#ifdef ESSENTIALS_SIMD_X86
+        if(detail::cpu::has_avx2()) return detail::csv_classify_avx2(p, dialect_.delimiter, dialect_.quote);
+        return detail::csv_classify_sse2(p, dialect_.delimiter, dialect_.quote);
+#else
+        return detail::csv_classify_scalar(p, dialect_.delimiter, dialect_.quote);
+#endif
+    }
+
+    static uint64_t quoted_bits(uint64_t quotes) noexcept {
+#ifdef ESSENTIALS_SIMD_X86
+        if(detail::cpu::has_pclmul()) return detail::prefix_xor_clmul(quotes);
+#endif
+        return detail::prefix_xor(quotes);
+    }
+
+    // the position of the next field end, npos past the input
+    size_t next_end() noexcept {
+        while(bits_ == 0) {
+            if(scanned_ >= data_.size()) return string_view::npos;
+            auto size = std::min<size_t>(64, data_.size() - scanned_);
+            detail::csv_masks masks;
+            if(size == 64) masks = classify(data_.data() + scanned_);
+            else {
+                // the tail goes through a padded copy; the padding bits are dropped below
+                char tail[64] = {};
+                std::memcpy(tail, data_.data() + scanned_, size);
+                masks = classify(tail);
+                auto valid = (uint64_t(1) << size) - 1;
+                masks.quote &= valid;
+                masks.structural &= valid;
+            }
+            auto inside = quoted_bits(masks.quote) ^ in_quotes_;
+            in_quotes_ = uint64_t(int64_t(inside) >> 63);
+            bits_ = masks.structural & ~inside;
+            block_ = scanned_;
+            scanned_ += 64;
+        }
+        auto res = block_ + size_t(__builtin_ctzll(bits_));
+        bits_ &= bits_ - 1;
+        return res;
+    }
+
+    void add_field(size_t end, bool last) {
+        if(last && dialect_.crlf && end > field_start_ && data_[end - 1] == '\r') --end;
+        fields_.emplace_back(data_.substr(field_start_, end - field_start_), dialect_.quote);
+    }
+
+public:
+    explicit csv_scanner(string_view data, csv_dialect dialect = csv_dialect()) noexcept: data_(data), dialect_(dialect) {}
+
+    // moves to the next record, false at the end of the input
+    bool next() {
+        fields_.clear();
+        if(field_start_ >= data_.size()) return false;
+        while(true) {
+            auto end = next_end();
+            if(end == string_view::npos) {
+                add_field(data_.size(), true);
+                field_start_ = data_.size();
+                return true;
+            }
+            auto newline = data_[end] == '\n';
+            add_field(end, newline);
+            field_start_ = end + 1;
+            if(newline) return true;
+        }
+    }
+
+    csv_record record() const noexcept { return csv_record(fields_.data(), fields_.data() + fields_.size()); }
+    // where the next record starts
+    size_t position() const noexcept { return field_start_; }
+    const csv_dialect& dialect() const noexcept { return dialect_; }
+};
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_CSV_SCANNER_HPP */
@@ -0,0 +1,282 @@
+#ifndef ESSENTIALS_GLOB_PATTERN_HPP
+#define ESSENTIALS_GLOB_PATTERN_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "multi_searcher.hpp"
+
+namespace essentials {
+
+/*
+ * A shell-style wildcard pattern compiled once and matched against whole strings.
+ * '*' matches any run of characters, '?' any single one, "[a-z_]" one of a class ("[!...]" or "[^...]" one
+ * outside it), and '\' makes the next character literal. No character is special to '*', '/' and '.' included.
+ *
+ * The pattern is split at its stars into segments of fixed length. The first one has to sit at the start
+ * of the input and the last one at its end; those are checked first. The ones in between are placed
+ * leftmost, left to right, which is the only placement worth trying, so nothing is ever backtracked.
+ * Each of them is looked for with a vectorized find of its longest literal run, only the candidates it
+ * turns up get compared in full. Literal-only segments thus cost linear time; one made of '?' and classes
+ * costs its own length per position at worst.
+ * Malformed patterns (an unterminated class, a trailing '\') throw std::invalid_argument.
+ */
+class glob_pattern {
+    enum class kind: uint8_t { literal, any, member, non_member };
+
+    struct unit {
+        kind what;
+        char c;
+        uint32_t set;
+    };
+
+    struct segment {
+        size_t first;
+        size_t size;
+        // the longest run of literals inside, relative to `first`
+        size_t literal;
+        size_t literal_size;
+    };
+
+    std::string source_;
+    std::vector<unit> units_;
+    // the character of every literal unit at the unit's index, so that literal runs are views into it
+    std::string literals_;
+    std::vector<basic_char_set<char>> sets_;
+    std::vector<segment> segments_;
+    bool star_ = false;
+    // the longest literal run of the pattern as a whole: segment and unit index
+    size_t prefilter_segment_ = 0;
+    size_t prefilter_ = 0;
+    size_t prefilter_size_ = 0;
+
+    void parse() {
+        auto p = string_view(source_);
+        size_t segment_first = 0;
+        bool after_star = false;
+        auto close_segment = [&]() {
+            segment seg{ segment_first, units_.size() - segment_first, 0, 0 };
+            for(size_t ix = 0, run = 0; ix < seg.size; ++ix) {
+                run = (units_[seg.first + ix].what == kind::literal)? run + 1 : 0;
+                if(run > seg.literal_size) {
+                    seg.literal = ix + 1 - run;
+                    seg.literal_size = run;
+                }
+            }
+            if(seg.literal_size > prefilter_size_) {
+                prefilter_segment_ = segments_.size();
+                prefilter_ = seg.first + seg.literal;
+                prefilter_size_ = seg.literal_size;
+            }
+            segments_.push_back(seg);
+            segment_first = units_.size();
+        };
+        auto add = [this](kind what, char c, uint32_t set) {
+            units_.push_back(unit{ what, c, set });
+            literals_.push_back((what == kind::literal)? c : '\0');
+        };
+
+        for(size_t ix = 0; ix < p.size(); ++ix) {
+            auto c = p[ix];
+            // runs of stars are one star
+            if(c == '*') {
+                if(!after_star) close_segment();
+                star_ = after_star = true;
+                continue;
+            }
+            after_star = false;
+            if(c == '?') add(kind::any, '\0', 0);
+            else if(c == '\\') {
+                if(++ix == p.size()) throw std::invalid_argument("glob_pattern: trailing '\\'");
+                add(kind::literal, p[ix], 0);
+            }
+            else if(c == '[') {
+                auto start = ix + 1;
+                auto negated = start < p.size() && (p[start] == '!' || p[start] == '^');
+                if(negated) ++start;
+                std::string members;
+                // a ']' right after the opening is a member
+                auto jx = start;
+                for(; jx < p.size() && (jx == start || p[jx] != ']'); ++jx) {
+                    auto lo = p[jx];
+                    if(lo == '\\' && jx + 1 < p.size()) lo = p[++jx];
+                    if(jx + 2 < p.size() && p[jx + 1] == '-' && p[jx + 2] != ']') {
+                        auto hi = p[jx + 2];
+                        if(hi == '\\' && jx + 3 < p.size()) hi = p[++jx + 2];
+                        for(auto u = unsigned(static_cast<unsigned char>(lo)); u <= static_cast<unsigned char>(hi); ++u)
+                            members.push_back(static_cast<char>(u));
+                        jx += 2;
+                    }
+                    else members.push_back(lo);
+                }
+                if(jx >= p.size()) throw std::invalid_argument("glob_pattern: unterminated '['");
+                sets_.emplace_back(string_view(members));
+                add(negated? kind::non_member : kind::member, '\0', uint32_t(sets_.size() - 1));
+                ix = jx;
+            }
+            else add(kind::literal, c, 0);
+        }
+        close_segment();
+    }
+
+    bool match_at(const segment& seg, const char* p) const noexcept {
+        if(seg.literal_size == seg.size) return string_view::traits_type::compare(p, literals_.data() + seg.first, seg.size) == 0;
+        for(size_t ix = 0; ix < seg.size; ++ix) {
+            auto&& u = units_[seg.first + ix];
+            switch(u.what) {
+            case kind::literal: if(p[ix] != u.c) return false; break;
+            case kind::any: break;
+            case kind::member: if(!sets_[u.set].contains(p[ix])) return false; break;
+            case kind::non_member: if(sets_[u.set].contains(p[ix])) return false; break;
+            }
+        }
+        return true;
+    }
+
+    // the leftmost start at or after `from` with the segment ending by `limit`, npos if there is none
+    size_t find_segment(const segment& seg, string_view s, size_t from, size_t limit) const noexcept {
+        if(seg.size > limit || from > limit - seg.size) return string_view::npos;
+        auto last = limit - seg.size;
+        if(seg.literal_size == 0) {
+            for(auto pos = from; pos <= last; ++pos)
+                if(match_at(seg, s.data() + pos)) return pos;
+            return string_view::npos;
+        }
+        auto literal = string_view(literals_.data() + seg.first + seg.literal, seg.literal_size);
+        // the literal run can only start where the whole segment still fits
+        auto window = string_view(s.data(), last + seg.literal + seg.literal_size);
+        for(auto at = window.find(literal, from + seg.literal); at != string_view::npos; at = window.find(literal, at + 1))
+            if(match_at(seg, s.data() + at - seg.literal)) return at - seg.literal;
+        return string_view::npos;
+    }
+
+public:
+    explicit glob_pattern(string_view pattern): source_(pattern) { parse(); }
+
+    string_view pattern() const noexcept { return source_; }
+    // the fewest characters a match has
+    size_t min_size() const noexcept { return units_.size(); }
+    // the longest literal run every match contains
+    string_view literal() const noexcept { return string_view(literals_.data() + prefilter_, prefilter_size_); }
+    // whether the pattern matches itself only
+    bool is_literal() const noexcept { return !star_ && prefilter_size_ == units_.size(); }
+
+    bool match(string_view s) const noexcept {
+        if(s.size() < units_.size()) return false;
+        if(!star_) return s.size() == units_.size() && match_at(segments_.front(), s.data());
+
+        auto&& head = segments_.front();
+        auto&& tail = segments_.back();
+        auto limit = s.size() - tail.size;
+        if(!match_at(head, s.data()) || !match_at(tail, s.data() + limit)) return false;
+        auto pos = head.size;
+        if(segments_.size() == 2) return true;
+        // the longest literal first, when it is further in the middle: most inputs that fail, fail on it
+        if(prefilter_segment_ > 1 && prefilter_segment_ + 1 != segments_.size()
+            && string_view(s.data() + pos, limit - pos).find(literal()) == string_view::npos) return false;
+        for(size_t ix = 1; ix + 1 < segments_.size(); ++ix) {
+            auto&& seg = segments_[ix];
+            auto at = find_segment(seg, s, pos, limit);
+            if(at == string_view::npos) return false;
+            pos = at + seg.size;
+        }
+        return true;
+    }
+
+    bool operator()(string_view s) const noexcept { return match(s); }
+};
+
+/*
+ * Many glob patterns matched against one input at once.
+ * The literal() of every pattern goes into a multi_searcher, so a single pass over the input tells
+ * which patterns can possibly match; only those, and the ones too unspecific to have a literal,
+ * are run in full.
+ */
+class glob_set {
+    std::vector<glob_pattern> patterns_;
+    // the patterns behind every multi_searcher pattern, and those with no literal worth looking for
+    std::vector<std::vector<size_t>> owners_;
+    std::vector<size_t> unfiltered_;
+    multi_searcher literals_;
+
+    std::vector<std::string> collect_literals() {
+        std::vector<std::string> res;
+        std::unordered_map<std::string, size_t> seen;
+        for(size_t ix = 0; ix < patterns_.size(); ++ix) {
+            auto literal = patterns_[ix].literal();
+            // single characters would hand every pattern over anyway
+            if(literal.size() < 2) {
+                unfiltered_.push_back(ix);
+                continue;
+            }
+            auto it = seen.emplace(std::string(literal), res.size()).first;
+            if(it->second == res.size()) {
+                res.push_back(it->first);
+                owners_.emplace_back();
+            }
+            owners_[it->second].push_back(ix);
+        }
+        return res;
+    }
+
+    static std::vector<glob_pattern> compile(std::initializer_list<string_view> patterns) {
+        return std::vector<glob_pattern>(patterns.begin(), patterns.end());
+    }
+
+    static multi_searcher make_searcher(const std::vector<std::string>& literals) {
+        return multi_searcher(literals.begin(), literals.end());
+    }
+
+public:
+    explicit glob_set(std::vector<glob_pattern> patterns):
+        patterns_(std::move(patterns)), literals_(make_searcher(collect_literals())) {}
+    glob_set(std::initializer_list<string_view> patterns): glob_set(compile(patterns)) {}
+    template<class It>
+    glob_set(It first, It last): glob_set(std::vector<glob_pattern>(first, last)) {}
+
+    size_t size() const noexcept { return patterns_.size(); }
+    const glob_pattern& operator[](size_t ix) const noexcept { return patterns_[ix]; }
+
+    // calls `f(ix)` for every pattern that matches, in increasing order of ix
+    template<class F>
+    void for_each_match(string_view s, F&& f) const {
+        std::vector<size_t> candidates(unfiltered_);
+        std::vector<bool> found(owners_.size());
+        literals_.for_each_match(s, [&](multi_searcher::match m) {
+            if(found[m.pattern]) return;
+            found[m.pattern] = true;
+            candidates.insert(candidates.end(), owners_[m.pattern].begin(), owners_[m.pattern].end());
+        });
+        std::sort(candidates.begin(), candidates.end());
+        for(auto ix : candidates)
+            if(patterns_[ix].match(s)) f(ix);
+    }
+
+    // the indices of the patterns that match, in increasing order
+    std::vector<size_t> match(string_view s) const {
+        std::vector<size_t> res;
+        for_each_match(s, [&res](size_t ix) { res.push_back(ix); });
+        return res;
+    }
+
+    bool match_any(string_view s) const {
+        for(auto ix : unfiltered_)
+            if(patterns_[ix].match(s)) return true;
+        // the owners of a literal are run once however often it occurs, and the first match ends the scan
+        std::vector<bool> found(owners_.size());
+        return literals_.any_match(s, [&](multi_searcher::match m) {
+            if(found[m.pattern]) return false;
+            found[m.pattern] = true;
+            for(auto ix : owners_[m.pattern])
+                if(patterns_[ix].match(s)) return true;
+            return false;
+        });
+    }
+};
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_GLOB_PATTERN_HPP */
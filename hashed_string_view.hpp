@@ -0,0 +1,90 @@
+#ifndef ESSENTIALS_HASHED_STRING_VIEW_HPP
+#define ESSENTIALS_HASHED_STRING_VIEW_HPP
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+/*
+ * A view that carries its hash.
+ * The hash is computed once on construction (at compile time for _sv literals),
+ * lookups into several tables reuse it instead of rehashing the key.
+ */
+template<class Char, class Traits = std::char_traits<Char>, class Hash = basic_string_view_hash<Char, Traits>>
+class basic_hashed_string_view {
+public:
+    using view_type = basic_string_view<Char, Traits>;
+    using hasher = Hash;
+    using traits_type = Traits;
+    using value_type = Char;
+    using size_type = size_t;
+    using const_iterator = typename view_type::const_iterator;
+    using iterator = const_iterator;
+
+private:
+    view_type view_;
+    size_t hash_;
+
+public:
+    constexpr basic_hashed_string_view() noexcept: view_(), hash_(Hash()(view_)) {}
+    constexpr basic_hashed_string_view(view_type v) noexcept: view_(v), hash_(Hash()(v)) {}
+    // `hash` must be what Hash gives for `v`
+    constexpr basic_hashed_string_view(view_type v, size_t hash) noexcept: view_(v), hash_(hash) {}
+    basic_hashed_string_view(const Char* s) noexcept: basic_hashed_string_view(view_type(s)) {}
+    basic_hashed_string_view(const std::basic_string<Char, Traits>& s) noexcept: basic_hashed_string_view(view_type(s)) {}
+
+    constexpr basic_hashed_string_view(const basic_hashed_string_view&) noexcept = default;
+    constexpr basic_hashed_string_view& operator=(const basic_hashed_string_view&) noexcept = default;
+
+    constexpr view_type view() const noexcept { return view_; }
+    constexpr operator view_type() const noexcept { return view_; }
+    constexpr size_t hash() const noexcept { return hash_; }
+
+    constexpr const Char* data() const noexcept { return view_.data(); }
+    constexpr size_type size() const noexcept { return view_.size(); }
+    constexpr bool empty() const noexcept { return view_.empty(); }
+    constexpr iterator begin() const noexcept { return view_.begin(); }
+    constexpr iterator end() const noexcept { return view_.end(); }
+
+    // same storage first (interned views), then the hash, then the characters
+    friend constexpr bool operator==(basic_hashed_string_view lhv, basic_hashed_string_view rhv) noexcept {
+        if(lhv.view_.size() != rhv.view_.size()) return false;
+        if(lhv.view_.data() == rhv.view_.data()) return true;
+        return lhv.hash_ == rhv.hash_ && lhv.view_ == rhv.view_;
+    }
+    friend constexpr bool operator!=(basic_hashed_string_view lhv, basic_hashed_string_view rhv) noexcept {
+        return not (lhv == rhv);
+    }
+# define COMPARE_TO_OP(OPC) \
+    friend constexpr bool operator OPC(basic_hashed_string_view lhv, basic_hashed_string_view rhv) noexcept { \
+        return lhv.view_ OPC rhv.view_; \
+    }
+
+    COMPARE_TO_OP(<)
+    COMPARE_TO_OP(<=)
+    COMPARE_TO_OP(>)
+    COMPARE_TO_OP(>=)
+
+# undef COMPARE_TO_OP
+};
+
+template<class Char, class Traits, class Hash>
+std::basic_ostream<Char, Traits>& operator<<(std::basic_ostream<Char, Traits>& os, basic_hashed_string_view<Char, Traits, Hash> v) {
+    return os << v.view();
+}
+
+using hashed_string_view = basic_hashed_string_view<char>;
+using whashed_string_view = basic_hashed_string_view<wchar_t>;
+
+} /* namespace essentials */
+
+namespace std {
+    template<class Char, class Traits, class Hash>
+    struct hash<essentials::basic_hashed_string_view<Char, Traits, Hash>> {
+        constexpr size_t operator()(essentials::basic_hashed_string_view<Char, Traits, Hash> v) const noexcept {
+            return v.hash();
+        }
+    };
+} /* namespace std */
+
+#endif /* ESSENTIALS_HASHED_STRING_VIEW_HPP */
@@ -0,0 +1,119 @@
+#ifndef ESSENTIALS_INSTRUMENT_HPP
+#define ESSENTIALS_INSTRUMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Opt-in counters for the hot paths of basic_string_view.
+ * Building with ESSENTIALS_INSTRUMENT defined (for every translation unit) turns them on:
+ * every find, rfind, find_*_of, compare and hash then counts its call, the code units it scanned,
+ * and the kernel it ran; find and rfind also count the candidates that failed verification.
+ * ESSENTIALS_INSTRUMENT_HISTOGRAM adds log2 histograms of haystack and needle sizes.
+ * Counters are per thread and never synchronized; view_stats_snapshot() copies the calling thread's.
+ * Without the macro the hooks compile to nothing and snapshots stay empty.
+ */
+
+namespace essentials {
+
+enum class view_op: unsigned {
+    find, rfind, find_first_of, find_last_of, find_first_not_of, find_last_not_of, compare, hash
+};
+constexpr size_t view_op_count = 8;
+
+enum class view_kernel: unsigned {
+    // a plain loop
+    scalar,
+    // memchr, memcmp and the like, through Traits
+    library,
+    sse2,
+    ssse3,
+    avx2,
+    two_way
+};
+constexpr size_t view_kernel_count = 6;
+
+inline const char* view_op_name(view_op op) noexcept {
+    static const char* const names[view_op_count] = {
+        "find", "rfind", "find_first_of", "find_last_of", "find_first_not_of", "find_last_not_of", "compare", "hash"
+    };
+    return names[unsigned(op)];
+}
+
+inline const char* view_kernel_name(view_kernel kernel) noexcept {
+    static const char* const names[view_kernel_count] = { "scalar", "library", "sse2", "ssse3", "avx2", "two_way" };
+    return names[unsigned(kernel)];
+}
+
+struct view_op_stats {
+    uint64_t calls = 0;
+    // code units looked at: up to and including a match, the whole range otherwise
+    uint64_t scanned = 0;
+    // anchor hits that turned out not to be a match (find and rfind)
+    uint64_t mismatches = 0;
+    uint64_t kernels[view_kernel_count] = {};
+    // bucket k counts sizes in [2^(k-1), 2^k), bucket 0 the empty ones
+    uint64_t haystack_sizes[65] = {};
+    uint64_t needle_sizes[65] = {};
+
+    uint64_t kernel(view_kernel k) const noexcept { return kernels[unsigned(k)]; }
+};
+
+struct view_stats {
+    view_op_stats ops[view_op_count];
+
+    const view_op_stats& operator[](view_op op) const noexcept { return ops[unsigned(op)]; }
+    view_op_stats& operator[](view_op op) noexcept { return ops[unsigned(op)]; }
+};
+
+namespace detail {
+
+inline view_stats& local_view_stats() noexcept {
+    static thread_local view_stats stats;
+    return stats;
+}
+
+inline unsigned size_bucket(size_t size) noexcept {
+    return (size == 0)? 0 : unsigned(64 - __builtin_clzll(uint64_t(size)));
+}
+
+inline void count_call(view_op op, size_t haystack, size_t needle, size_t scanned) noexcept {
+    auto&& stats = local_view_stats()[op];
+    ++stats.calls;
+    stats.scanned += scanned;
+#ifdef ESSENTIALS_INSTRUMENT_HISTOGRAM
+    ++stats.haystack_sizes[size_bucket(haystack)];
+    ++stats.needle_sizes[size_bucket(needle)];
+#else
+    (void) haystack;
+    (void) needle;
+#endif
+}
+
+inline void count_kernel(view_op op, view_kernel kernel) noexcept {
+    ++local_view_stats()[op].kernels[unsigned(kernel)];
+}
+
+inline void count_mismatch(view_op op) noexcept {
+    ++local_view_stats()[op].mismatches;
+}
+
+} /* namespace detail */
+
+// a copy of the calling thread's counters
+inline view_stats view_stats_snapshot() noexcept { return detail::local_view_stats(); }
+
+inline void view_stats_reset() noexcept { detail::local_view_stats() = view_stats(); }
+
+// whether the hooks are compiled in
+constexpr bool view_stats_enabled() noexcept {
+#ifdef ESSENTIALS_INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+}
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_INSTRUMENT_HPP */
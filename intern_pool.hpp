@@ -0,0 +1,113 @@
+#ifndef ESSENTIALS_INTERN_POOL_HPP
+#define ESSENTIALS_INTERN_POOL_HPP
+
+#include <vector>
+
+#include "hashed_string_view.hpp"
+#include "string_arena.hpp"
+
+namespace essentials {
+
+/*
+ * Interning pool: every distinct string is copied once into arena storage,
+ * equal strings come back as the same stable view (so equality is a pointer comparison).
+ * Storage is allocated a chunk at a time, the index is an open-addressing table of cached hashes.
+ */
+template<class Char, class Traits = std::char_traits<Char>, class Hash = basic_string_view_hash<Char, Traits>>
+class basic_intern_pool {
+public:
+    using view_type = basic_string_view<Char, Traits>;
+    using hashed_view_type = basic_hashed_string_view<Char, Traits, Hash>;
+
+private:
+    struct slot {
+        const Char* data = nullptr;
+        size_t size = 0;
+        size_t hash = 0;
+        bool used = false;
+    };
+
+    basic_string_arena<Char, Traits> arena_;
+    std::vector<slot> slots_;
+    size_t size_ = 0;
+
+    size_t mask() const noexcept { return slots_.size() - 1; }
+
+    // index of the slot holding `v` or of the empty slot where it belongs; the table must not be empty
+    size_t position(hashed_view_type v) const noexcept {
+        for(auto ix = v.hash() & mask();; ix = (ix + 1) & mask()) {
+            auto&& s = slots_[ix];
+            if(!s.used) return ix;
+            if(s.hash == v.hash() && s.size == v.size() && Traits::compare(s.data, v.data(), s.size) == 0)
+                return ix;
+        }
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<slot> old(capacity);
+        old.swap(slots_);
+        for(auto&& s : old) {
+            if(!s.used) continue;
+            auto ix = s.hash & mask();
+            while(slots_[ix].used) ix = (ix + 1) & mask();
+            slots_[ix] = s;
+        }
+    }
+
+public:
+    explicit basic_intern_pool(size_t chunk_size = 64 * 1024): arena_(chunk_size) {}
+
+    basic_intern_pool(const basic_intern_pool&) = delete;
+    basic_intern_pool& operator=(const basic_intern_pool&) = delete;
+    basic_intern_pool(basic_intern_pool&&) = default;
+    basic_intern_pool& operator=(basic_intern_pool&&) = default;
+
+    // views, strings and hashed views with a precomputed hash all convert to hashed_view_type
+    hashed_view_type intern(hashed_view_type v) {
+        // keep the load factor at or below 1/2
+        if(2 * (size_ + 1) > slots_.size()) rehash(slots_.empty()? 64 : slots_.size() * 2);
+        auto&& s = slots_[position(v)];
+        if(!s.used) {
+            // allocate, not store: an interned empty string still needs a non-null data()
+            auto data = arena_.allocate(v.size());
+            Traits::copy(data, v.data(), v.size());
+            s = slot{ data, v.size(), v.hash(), true };
+            ++size_;
+        }
+        return hashed_view_type(view_type(s.data, s.size), s.hash);
+    }
+
+    // the interned view if `v` was interned before, an empty view with a null data() otherwise
+    hashed_view_type find(hashed_view_type v) const noexcept {
+        if(slots_.empty()) return hashed_view_type(view_type(), 0);
+        auto&& s = slots_[position(v)];
+        if(!s.used) return hashed_view_type(view_type(), 0);
+        return hashed_view_type(view_type(s.data, s.size), s.hash);
+    }
+    bool contains(hashed_view_type v) const noexcept {
+        return !slots_.empty() && slots_[position(v)].used;
+    }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    // chunks and large blocks the arena holds
+    size_t chunks() const noexcept {
+        auto stats = arena_.stats();
+        return stats.chunks + stats.large_blocks;
+    }
+    arena_stats memory() const noexcept { return arena_.stats(); }
+
+    // invalidates every view handed out so far
+    void clear() noexcept {
+        arena_.release();
+        slots_.clear();
+        size_ = 0;
+    }
+};
+
+using intern_pool = basic_intern_pool<char>;
+using wintern_pool = basic_intern_pool<wchar_t>;
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_INTERN_POOL_HPP */
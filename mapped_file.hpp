@@ -0,0 +1,123 @@
+#ifndef ESSENTIALS_MAPPED_FILE_HPP
+#define ESSENTIALS_MAPPED_FILE_HPP
+
+#include <cerrno>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "string_view.hpp"
+#include "split.hpp"
+
+namespace essentials {
+
+enum class map_advice { normal, sequential, random, willneed };
+
+/*
+ * A read-only file mapped into memory, viewed as a single string_view.
+ * Nothing is read up front, pages come in on first touch.
+ * Advice and huge pages are hints: the kernel is free to ignore them and so are we.
+ * Failures to open, stat or map the file throw std::system_error.
+ * Views taken from the file are valid while it stays mapped.
+ */
+class mapped_file {
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+
+    static int to_madvise(map_advice advice) noexcept {
+        switch(advice) {
+            case map_advice::sequential: return MADV_SEQUENTIAL;
+            case map_advice::random: return MADV_RANDOM;
+            case map_advice::willneed: return MADV_WILLNEED;
+            default: return MADV_NORMAL;
+        }
+    }
+
+    static std::system_error error(const char* what, const std::string& path) {
+        return std::system_error(errno, std::generic_category(), std::string("mapped_file: ") + what + " " + path);
+    }
+
+public:
+    mapped_file() noexcept = default;
+
+    explicit mapped_file(const std::string& path, map_advice advice = map_advice::normal, bool huge_pages = false) {
+        auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd < 0) throw error("cannot open", path);
+        struct stat st;
+        if(::fstat(fd, &st) != 0) {
+            auto err = error("cannot stat", path);
+            ::close(fd);
+            throw err;
+        }
+        size_ = size_t(st.st_size);
+        // mmap refuses empty mappings, an empty file is just an empty view
+        if(size_ != 0) {
+            auto addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(addr == MAP_FAILED) {
+                auto err = error("cannot map", path);
+                ::close(fd);
+                throw err;
+            }
+            data_ = static_cast<const char*>(addr);
+        }
+        // the mapping keeps its own reference to the file
+        ::close(fd);
+#ifdef MADV_HUGEPAGE
+        if(huge_pages) advise_all(MADV_HUGEPAGE);
+#else
+        (void) huge_pages;
+#endif
+        if(advice != map_advice::normal) advise(advice);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& that) noexcept:
+        data_(std::exchange(that.data_, nullptr)), size_(std::exchange(that.size_, 0)) {}
+    mapped_file& operator=(mapped_file&& that) noexcept {
+        if(this != &that) {
+            unmap();
+            data_ = std::exchange(that.data_, nullptr);
+            size_ = std::exchange(that.size_, 0);
+        }
+        return *this;
+    }
+
+    ~mapped_file() { unmap(); }
+
+    void unmap() noexcept {
+        if(data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    // changes the access pattern hint for the whole file
+    void advise(map_advice advice) const noexcept {
+        advise_all(to_madvise(advice));
+    }
+
+    bool is_mapped() const noexcept { return data_ != nullptr; }
+    const char* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    string_view view() const noexcept { return string_view(data_, size_); }
+    operator string_view() const noexcept { return view(); }
+
+    basic_line_range<char, std::char_traits<char>> lines() const noexcept { return essentials::lines(view()); }
+
+private:
+    void advise_all(int flag) const noexcept {
+        if(data_ != nullptr) ::madvise(const_cast<char*>(data_), size_, flag);
+    }
+};
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_MAPPED_FILE_HPP */
@@ -0,0 +1,470 @@
+#ifndef ESSENTIALS_MULTI_SEARCHER_HPP
+#define ESSENTIALS_MULTI_SEARCHER_HPP
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+namespace detail {
+
+// the constants of multi_searcher: a template, so that their out-of-class definitions may live in the header
+template<class Dummy = void>
+struct multi_searcher_constants {
+    static constexpr size_t npos = string_view::npos;
+    // Teddy has eight buckets, past this many patterns per bucket verification dominates
+    static constexpr size_t teddy_limit = 32;
+};
+
+template<class Dummy>
+constexpr size_t multi_searcher_constants<Dummy>::npos;
+template<class Dummy>
+constexpr size_t multi_searcher_constants<Dummy>::teddy_limit;
+
+} /* namespace detail */
+
+/*
+ * Finds any of a set of patterns in a single pass over the haystack.
+ * Small sets use Teddy (SIMD nibble fingerprints of the first bytes of every pattern,
+ * candidates verified against their bucket), large ones a double-array Aho-Corasick automaton.
+ * Patterns are copied on construction; empty patterns never match.
+ */
+class multi_searcher: public detail::multi_searcher_constants<> {
+public:
+    struct match {
+        size_t pattern;
+        size_t offset;
+
+        friend bool operator==(match lhv, match rhv) noexcept {
+            return lhv.pattern == rhv.pattern && lhv.offset == rhv.offset;
+        }
+        friend bool operator!=(match lhv, match rhv) noexcept { return not (lhv == rhv); }
+        // leftmost first, lower pattern ids first on ties
+        friend bool operator<(match lhv, match rhv) noexcept {
+            return lhv.offset < rhv.offset || (lhv.offset == rhv.offset && lhv.pattern < rhv.pattern);
+        }
+    };
+
+    enum class engine { automatic, teddy, aho_corasick };
+
+private:
+    std::string storage_;
+    std::vector<size_t> offsets_;
+    std::vector<size_t> sizes_;
+    size_t min_size_ = npos;
+    size_t max_size_ = 0;
+    engine engine_ = engine::aho_corasick;
+
+    // Teddy: masks_[pos] holds 16 bytes of low-nibble then 16 bytes of high-nibble bucket bits
+    size_t teddy_width_ = 0;
+    alignas(16) uint8_t masks_[3][32] = {};
+    std::vector<size_t> buckets_[8];
+
+    // Aho-Corasick over a double array: state s goes to t = base + c when check[t] == s
+    struct cell {
+        int32_t base = 0;
+        int32_t check = -1;
+    };
+    std::vector<cell> cells_;
+    std::vector<int32_t> fail_;
+    // nearest state on the failure chain (the state itself included) with outputs, -1 if none
+    std::vector<int32_t> output_link_;
+    std::vector<uint32_t> output_begin_;
+    std::vector<uint32_t> outputs_;
+
+public:
+    template<class It>
+    multi_searcher(It first, It last, engine kind = engine::automatic) {
+        for(; first != last; ++first) add(string_view(*first));
+        build(kind);
+    }
+    explicit multi_searcher(const std::vector<string_view>& patterns, engine kind = engine::automatic):
+        multi_searcher(patterns.begin(), patterns.end(), kind) {}
+    multi_searcher(std::initializer_list<string_view> patterns, engine kind = engine::automatic):
+        multi_searcher(patterns.begin(), patterns.end(), kind) {}
+
+    size_t size() const noexcept { return sizes_.size(); }
+    string_view pattern(size_t ix) const noexcept { return string_view(storage_.data() + offsets_[ix], sizes_[ix]); }
+    engine kind() const noexcept { return engine_; }
+
+    // calls `f(match)` for every occurrence of every pattern, overlapping ones included
+    template<class F>
+    void for_each_match(string_view hay, F&& f) const {
+        if(sizes_.empty() || min_size_ > hay.size()) return;
+        size_t last_start = npos;
+        scan(hay, [&f](match m) { f(m); return true; }, last_start);
+    }
+
+    // every match, sorted by offset and then by pattern id
+    std::vector<match> find_all(string_view hay) const {
+        std::vector<match> res;
+        for_each_match(hay, [&res](match m) { res.push_back(m); });
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+
+    // the leftmost match (the lowest pattern id on ties), { npos, npos } if there is none
+    match find_first(string_view hay) const {
+        match best{ npos, npos };
+        if(sizes_.empty() || min_size_ > hay.size()) return best;
+        // matches starting past the best one so far are not worth looking for
+        size_t last_start = npos;
+        scan(hay, [&best, &last_start](match m) {
+            if(m < best) best = m;
+            last_start = best.offset;
+            return true;
+        }, last_start);
+        return best;
+    }
+
+    // whether `f(match)` returns true for some match; the scan stops at the first one that does
+    template<class F>
+    bool any_match(string_view hay, F&& f) const {
+        if(sizes_.empty() || min_size_ > hay.size()) return false;
+        bool found = false;
+        size_t last_start = npos;
+        scan(hay, [&f, &found](match m) { found = f(m); return !found; }, last_start);
+        return found;
+    }
+
+    bool contains_any(string_view hay) const {
+        return any_match(hay, [](match) { return true; });
+    }
+
+private:
+    void add(string_view pattern) {
+        offsets_.push_back(storage_.size());
+        sizes_.push_back(pattern.size());
+        storage_.append(pattern.data(), pattern.size());
+        if(pattern.empty()) return;
+        min_size_ = std::min(min_size_, pattern.size());
+        max_size_ = std::max(max_size_, pattern.size());
+    }
+
+    void build(engine kind) {
+        if(kind == engine::automatic) kind = (sizes_.size() <= teddy_limit)? engine::teddy : engine::aho_corasick;
+#ifdef ESSENTIALS_SIMD_X86
+        if(kind == engine::teddy && min_size_ != npos && detail::cpu::has_ssse3()) {
+            build_teddy();
+            return;
+        }
+#endif
+        build_aho_corasick();
+    }
+
+    /*
+     * Calls `f` for the matches until it returns false, or until no match starting by `last_start`
+     * can be left: the callback may lower it as it goes.
+     */
+    template<class F>
+    void scan(string_view hay, F&& f, const size_t& last_start) const {
+#ifdef ESSENTIALS_SIMD_X86
+        if(engine_ == engine::teddy) {
+            scan_teddy(hay, f, last_start);
+            return;
+        }
+#endif
+        scan_aho_corasick(hay, f, last_start);
+    }
+
+    /* Teddy */
+
+    void build_teddy() {
+        engine_ = engine::teddy;
+        teddy_width_ = std::min<size_t>(3, min_size_);
+        // neighbours in sorted order share prefixes, so contiguous groups keep the fingerprints sharp
+        std::vector<size_t> order;
+        for(size_t ix = 0; ix < sizes_.size(); ++ix)
+            if(sizes_[ix] != 0) order.push_back(ix);
+        std::sort(order.begin(), order.end(), [this](size_t lhv, size_t rhv) { return pattern(lhv) < pattern(rhv); });
+        auto per_bucket = (order.size() + 7) / 8;
+        for(size_t ix = 0; ix < order.size(); ++ix) {
+            auto bucket = ix / per_bucket;
+            auto p = pattern(order[ix]);
+            buckets_[bucket].push_back(order[ix]);
+            for(size_t pos = 0; pos < teddy_width_; ++pos) {
+                auto u = static_cast<unsigned char>(p[pos]);
+                masks_[pos][u & 15] |= uint8_t(1u << bucket);
+                masks_[pos][16 + (u >> 4)] |= uint8_t(1u << bucket);
+            }
+        }
+    }
+
+    uint8_t teddy_bits(const char* at, size_t left) const noexcept {
+        uint8_t bits = 0xFF;
+        for(size_t pos = 0; pos < teddy_width_ && pos < left; ++pos) {
+            auto u = static_cast<unsigned char>(at[pos]);
+            bits &= masks_[pos][u & 15] & masks_[pos][16 + (u >> 4)];
+        }
+        return bits;
+    }
+
+    // verifies the candidate start `at` against the buckets in `bits`; false stops the scan
+    template<class F>
+    bool teddy_verify(string_view hay, size_t at, unsigned bits, F& f) const {
+        while(bits != 0) {
+            auto bucket = size_t(__builtin_ctz(bits));
+            bits &= bits - 1;
+            for(auto ix : buckets_[bucket]) {
+                auto size = sizes_[ix];
+                if(size <= hay.size() - at && std::memcmp(hay.data() + at, storage_.data() + offsets_[ix], size) == 0)
+                    if(!f(match{ ix, at })) return false;
+            }
+        }
+        return true;
+    }
+
+#ifdef ESSENTIALS_SIMD_X86
+    __attribute__((target("avx2")))
+    size_t scan_teddy_avx2(string_view hay, uint8_t* lanes) const noexcept {
+        __m256i lo[3], hi[3];
+        for(size_t pos = 0; pos < teddy_width_; ++pos) {
+            lo[pos] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(masks_[pos])));
+            hi[pos] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(masks_[pos] + 16)));
+        }
+        const __m256i nibble = _mm256_set1_epi8(0x0f);
+        size_t i = 0;
+        for(; i + 32 + teddy_width_ - 1 <= hay.size(); i += 32) {
+            auto res = _mm256_set1_epi8(-1);
+            for(size_t pos = 0; pos < teddy_width_; ++pos) {
+                auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay.data() + i + pos));
+                auto l = _mm256_shuffle_epi8(lo[pos], _mm256_and_si256(v, nibble));
+                auto h = _mm256_shuffle_epi8(hi[pos], _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+                res = _mm256_and_si256(res, _mm256_and_si256(l, h));
+            }
+            if(!_mm256_testz_si256(res, res)) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), res);
+                return i;
+            }
+        }
+        return i | (size_t(1) << (sizeof(size_t) * 8 - 1));
+    }
+
+    __attribute__((target("ssse3")))
+    size_t scan_teddy_ssse3(string_view hay, size_t i, uint8_t* lanes) const noexcept {
+        __m128i lo[3], hi[3];
+        for(size_t pos = 0; pos < teddy_width_; ++pos) {
+            lo[pos] = _mm_load_si128(reinterpret_cast<const __m128i*>(masks_[pos]));
+            hi[pos] = _mm_load_si128(reinterpret_cast<const __m128i*>(masks_[pos] + 16));
+        }
+        const __m128i nibble = _mm_set1_epi8(0x0f);
+        for(; i + 16 + teddy_width_ - 1 <= hay.size(); i += 16) {
+            auto res = _mm_set1_epi8(-1);
+            for(size_t pos = 0; pos < teddy_width_; ++pos) {
+                auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay.data() + i + pos));
+                auto l = _mm_shuffle_epi8(lo[pos], _mm_and_si128(v, nibble));
+                auto h = _mm_shuffle_epi8(hi[pos], _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+                res = _mm_and_si128(res, _mm_and_si128(l, h));
+            }
+            if(_mm_movemask_epi8(_mm_cmpeq_epi8(res, _mm_setzero_si128())) != 0xFFFF) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), res);
+                return i;
+            }
+        }
+        return i | (size_t(1) << (sizeof(size_t) * 8 - 1));
+    }
+
+    /*
+     * The block scanners return the start of a block with candidates (lanes filled in),
+     * or, with the top bit set, the position where the scalar tail takes over.
+     */
+    // candidates are verified in order of their start, so the scan ends at the first one past `last_start`
+    template<class F>
+    void scan_teddy(string_view hay, F& f, const size_t& last_start) const {
+        constexpr size_t tail_flag = size_t(1) << (sizeof(size_t) * 8 - 1);
+        alignas(32) uint8_t lanes[32];
+        size_t i = 0;
+        if(detail::cpu::has_avx2()) {
+            while(true) {
+                auto at = scan_teddy_avx2(string_view(hay.data() + i, hay.size() - i), lanes);
+                if(at & tail_flag) {
+                    i += at & ~tail_flag;
+                    break;
+                }
+                i += at;
+                for(size_t lane = 0; lane < 32; ++lane) {
+                    if(i + lane > last_start) return;
+                    if(lanes[lane] != 0 && !teddy_verify(hay, i + lane, lanes[lane], f)) return;
+                }
+                i += 32;
+            }
+        }
+        while(true) {
+            auto at = scan_teddy_ssse3(hay, i, lanes);
+            if(at & tail_flag) {
+                i = at & ~tail_flag;
+                break;
+            }
+            i = at;
+            for(size_t lane = 0; lane < 16; ++lane) {
+                if(i + lane > last_start) return;
+                if(lanes[lane] != 0 && !teddy_verify(hay, i + lane, lanes[lane], f)) return;
+            }
+            i += 16;
+        }
+        for(; i + min_size_ <= hay.size() && i <= last_start; ++i) {
+            auto bits = teddy_bits(hay.data() + i, hay.size() - i);
+            if(bits != 0 && !teddy_verify(hay, i, bits, f)) return;
+        }
+    }
+#endif
+
+    /* Aho-Corasick */
+
+    void build_aho_corasick() {
+        engine_ = engine::aho_corasick;
+
+        // a plain trie first, children kept sorted by label
+        struct node {
+            std::vector<std::pair<unsigned char, int32_t>> children;
+            std::vector<uint32_t> outputs;
+            int32_t fail = 0;
+            int32_t slot = 0;
+        };
+        std::vector<node> trie(1);
+        for(size_t ix = 0; ix < sizes_.size(); ++ix) {
+            if(sizes_[ix] == 0) continue;
+            int32_t current = 0;
+            for(auto c : pattern(ix)) {
+                auto label = static_cast<unsigned char>(c);
+                auto&& children = trie[size_t(current)].children;
+                auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(label, int32_t(0)),
+                    [](std::pair<unsigned char, int32_t> lhv, std::pair<unsigned char, int32_t> rhv) { return lhv.first < rhv.first; });
+                if(it != children.end() && it->first == label) {
+                    current = it->second;
+                    continue;
+                }
+                auto next = int32_t(trie.size());
+                children.insert(it, std::make_pair(label, next));
+                trie.emplace_back();
+                current = next;
+            }
+            trie[size_t(current)].outputs.push_back(uint32_t(ix));
+        }
+
+        // breadth-first: failure links, then double-array placement in the same order
+        std::vector<int32_t> order{ 0 };
+        for(size_t head = 0; head < order.size(); ++head) {
+            auto parent = order[head];
+            for(auto&& child : trie[size_t(parent)].children) {
+                // children of the root fail to the root, the rest follow the parent's chain
+                int32_t target = 0;
+                for(auto fail = trie[size_t(parent)].fail; parent != 0; fail = trie[size_t(fail)].fail) {
+                    auto&& candidates = trie[size_t(fail)].children;
+                    auto it = std::find_if(candidates.begin(), candidates.end(),
+                        [&child](std::pair<unsigned char, int32_t> p) { return p.first == child.first; });
+                    if(it != candidates.end()) {
+                        target = it->second;
+                        break;
+                    }
+                    if(fail == 0) break;
+                }
+                trie[size_t(child.second)].fail = target;
+                order.push_back(child.second);
+            }
+        }
+
+        cells_.assign(512, cell());
+        cells_[0].check = 0;
+        // next_free[ix] leads to the first free cell at or after ix (path-compressed, like a union-find)
+        std::vector<size_t> next_free(cells_.size());
+        for(size_t ix = 0; ix < next_free.size(); ++ix) next_free[ix] = ix;
+        next_free[0] = 1;
+        auto reserve = [&](size_t ix) {
+            if(ix < next_free.size()) return;
+            auto old = next_free.size();
+            auto grown = std::max(old * 2, ix + 257);
+            cells_.resize(grown);
+            next_free.resize(grown);
+            for(auto k = old; k < grown; ++k) next_free[k] = k;
+        };
+        auto first_free = [&](size_t ix) {
+            reserve(ix);
+            auto root = ix;
+            while(next_free[root] != root) {
+                root = next_free[root];
+                reserve(root);
+            }
+            while(next_free[ix] != root) {
+                auto next = next_free[ix];
+                next_free[ix] = root;
+                ix = next;
+            }
+            return root;
+        };
+        for(auto id : order) {
+            auto&& n = trie[size_t(id)];
+            if(n.children.empty()) continue;
+            auto front = size_t(n.children.front().first);
+            // the lowest child takes some free cell, the rest of the children have to fit around it
+            size_t base = 0;
+            for(auto at = first_free(front + 1); ; at = first_free(at + 1)) {
+                base = at - front;
+                reserve(base + n.children.back().first);
+                bool fits = true;
+                for(auto&& child : n.children)
+                    if(cells_[base + child.first].check != -1) { fits = false; break; }
+                if(fits) break;
+            }
+            cells_[size_t(n.slot)].base = int32_t(base);
+            for(auto&& child : n.children) {
+                auto slot = base + child.first;
+                cells_[slot].check = n.slot;
+                next_free[slot] = slot + 1;
+                trie[size_t(child.second)].slot = int32_t(slot);
+            }
+        }
+        while(!cells_.empty() && cells_.back().check == -1) cells_.pop_back();
+
+        fail_.assign(cells_.size(), 0);
+        output_link_.assign(cells_.size(), -1);
+        output_begin_.assign(cells_.size() + 1, 0);
+        for(auto&& n : trie) {
+            fail_[size_t(n.slot)] = trie[size_t(n.fail)].slot;
+            output_begin_[size_t(n.slot) + 1] = uint32_t(n.outputs.size());
+        }
+        for(size_t ix = 1; ix < output_begin_.size(); ++ix) output_begin_[ix] += output_begin_[ix - 1];
+        outputs_.resize(output_begin_.back());
+        for(auto&& n : trie)
+            std::copy(n.outputs.begin(), n.outputs.end(), outputs_.begin() + output_begin_[size_t(n.slot)]);
+        // parents come before children in `order`, so the failure target is always resolved first
+        for(auto id : order) {
+            auto&& n = trie[size_t(id)];
+            if(!n.outputs.empty()) output_link_[size_t(n.slot)] = n.slot;
+            else if(id != 0) output_link_[size_t(n.slot)] = output_link_[size_t(trie[size_t(n.fail)].slot)];
+        }
+    }
+
+    int32_t next_state(int32_t state, unsigned char c) const noexcept {
+        while(true) {
+            auto target = size_t(cells_[size_t(state)].base) + c;
+            if(target < cells_.size() && cells_[target].check == state && target != 0) return int32_t(target);
+            if(state == 0) return 0;
+            state = fail_[size_t(state)];
+        }
+    }
+
+    // matches are reported by their end, one ending at ix or later starts past ix - max_size_
+    template<class F>
+    void scan_aho_corasick(string_view hay, F& f, const size_t& last_start) const {
+        int32_t state = 0;
+        for(size_t ix = 0; ix < hay.size(); ++ix) {
+            if(last_start != npos && ix >= last_start + max_size_) return;
+            state = next_state(state, static_cast<unsigned char>(hay[ix]));
+            for(auto out = output_link_[size_t(state)]; out != -1; out = output_link_[size_t(fail_[size_t(out)])]) {
+                for(auto o = output_begin_[size_t(out)]; o != output_begin_[size_t(out) + 1]; ++o) {
+                    auto pattern = outputs_[o];
+                    if(!f(match{ pattern, ix + 1 - sizes_[pattern] })) return;
+                }
+            }
+        }
+    }
+};
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_MULTI_SEARCHER_HPP */
@@ -0,0 +1,356 @@
+#ifndef ESSENTIALS_PARALLEL_HPP
+#define ESSENTIALS_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "string_view.hpp"
+#include "searcher.hpp"
+
+namespace essentials {
+
+/*
+ * A fixed set of worker threads, each with its own task deque.
+ * Workers take their newest task first and steal the oldest ones from the others when out of work;
+ * tasks submitted from a worker go to its own deque, the rest are spread round-robin.
+ * Any type with `execute(std::function<void()>)` can stand in for it as an executor.
+ * A task that throws does not take its worker down: the first such exception is kept for rethrow_failure().
+ */
+class thread_pool {
+    struct queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> next_{ 0 };
+    std::atomic<size_t> pending_{ 0 };
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    std::mutex failure_mutex_;
+    std::exception_ptr failure_;
+
+    // the pool and the index of the calling thread, if it is a worker
+    static std::pair<const thread_pool*, size_t>& current() noexcept {
+        static thread_local std::pair<const thread_pool*, size_t> slot{ nullptr, 0 };
+        return slot;
+    }
+
+    bool try_pop(size_t self, std::function<void()>& task) {
+        {
+            auto&& own = *queues_[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if(!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        for(size_t shift = 1; shift < queues_.size(); ++shift) {
+            auto&& victim = *queues_[(self + shift) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if(!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(size_t self) {
+        current() = { this, self };
+        std::function<void()> task;
+        while(true) {
+            if(try_pop(self, task)) {
+                --pending_;
+                try {
+                    task();
+                } catch(...) {
+                    std::lock_guard<std::mutex> lock(failure_mutex_);
+                    if(!failure_) failure_ = std::current_exception();
+                }
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_.wait(lock, [this] { return pending_ != 0 || stop_; });
+            if(stop_ && pending_ == 0) return;
+        }
+    }
+
+public:
+    // `threads == 0` means one per hardware thread
+    explicit thread_pool(unsigned threads = 0) {
+        if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        for(unsigned ix = 0; ix < threads; ++ix) queues_.emplace_back(new queue());
+        for(unsigned ix = 0; ix < threads; ++ix) threads_.emplace_back([this, ix] { run(ix); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    // runs whatever is still queued, then joins the workers
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for(auto&& t : threads_) t.join();
+    }
+
+    size_t size() const noexcept { return threads_.size(); }
+
+    void execute(std::function<void()> task) {
+        auto&& self = current();
+        auto target = (self.first == this)? self.second : next_++ % queues_.size();
+        // counted before it is visible, so that a worker taking it never sees the count go below zero
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            ++pending_;
+        }
+        {
+            auto&& q = *queues_[target];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(task));
+        }
+        wake_.notify_one();
+    }
+
+    // rethrows (and forgets) the first exception that escaped a task, if any did
+    void rethrow_failure() {
+        std::exception_ptr failure;
+        {
+            std::lock_guard<std::mutex> lock(failure_mutex_);
+            std::swap(failure, failure_);
+        }
+        if(failure) std::rethrow_exception(failure);
+    }
+
+    // the pool used when no executor is given, one worker per hardware thread
+    static thread_pool& shared() {
+        static thread_pool pool;
+        return pool;
+    }
+};
+
+// runs every task right away on the calling thread
+struct inline_executor {
+    void execute(std::function<void()> task) const { task(); }
+};
+
+namespace detail {
+
+/*
+ * Calls `f(ix)` for every ix in [0, count) on the executor and returns once all calls are done.
+ * The calling thread takes chunks as well, so a busy (or nested) executor only costs parallelism.
+ * Helpers that start after the last chunk was taken leave without touching `f`.
+ * If `f` throws, the chunks nobody started yet are skipped and the first exception is rethrown here.
+ */
+template<class Executor, class F>
+void parallel_chunks(Executor& executor, size_t count, F&& f) {
+    struct state {
+        std::atomic<size_t> next{ 0 };
+        std::atomic<bool> failed{ false };
+        size_t done = 0;
+        std::exception_ptr failure;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto shared = std::make_shared<state>();
+    std::function<void(size_t)> body = std::ref(f);
+    auto drain = [shared, &body, count] {
+        size_t completed = 0;
+        std::exception_ptr failure;
+        for(auto ix = shared->next++; ix < count; ix = shared->next++) {
+            if(!shared->failed) {
+                try {
+                    body(ix);
+                } catch(...) {
+                    shared->failed = true;
+                    if(!failure) failure = std::current_exception();
+                }
+            }
+            ++completed;
+        }
+        if(completed == 0) return;
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        if(failure && !shared->failure) shared->failure = failure;
+        shared->done += completed;
+        if(shared->done == count) shared->finished.notify_all();
+    };
+    for(size_t ix = 1; ix < count; ++ix)
+        executor.execute(drain);
+    drain();
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    shared->finished.wait(lock, [&shared, count] { return shared->done == count; });
+    if(shared->failure) std::rethrow_exception(shared->failure);
+}
+
+// chunk `ix` covers the matches starting in [ix * size, (ix + 1) * size)
+template<class Char, class Traits>
+struct chunking {
+    using view_type = basic_string_view<Char, Traits>;
+
+    view_type hay;
+    size_t needle_size;
+    size_t size;
+    size_t count;
+
+    chunking(view_type h, size_t m, size_t chunk_size) noexcept: hay(h), needle_size(m) {
+        // a few chunks per hardware thread so that stealing can even out the load
+        size = chunk_size;
+        if(size == 0) size = std::max<size_t>(size_t(1) << 20, hay.size() / (8 * std::max(1u, std::thread::hardware_concurrency())));
+        count = (hay.size() + size - 1) / size;
+    }
+
+    // the part of the view a chunk searches: it overlaps the next one by needle_size - 1
+    view_type region(size_t ix) const noexcept {
+        auto start = ix * size;
+        auto end = std::min(hay.size(), start + size + needle_size - 1);
+        return view_type(hay.data() + start, end - start);
+    }
+};
+
+} /* namespace detail */
+
+/*
+ * Searches a large view on all cores: it is cut into chunks that overlap by needle.size() - 1,
+ * so every match belongs to exactly one chunk, and the per-chunk results are merged in order.
+ * Views shorter than two chunks are searched on the calling thread.
+ * `chunk_size == 0` picks a size from the view size and the hardware concurrency.
+ * Matches may overlap; an empty needle matches nowhere in parallel_find_all and parallel_count.
+ */
+template<class Char, class Traits, class Executor>
+typename basic_string_view<Char, Traits>::size_type
+parallel_find(basic_string_view<Char, Traits> hay, typename detail::identity<basic_string_view<Char, Traits>>::type needle,
+              Executor& executor, size_t chunk_size = 0) {
+    using view_type = basic_string_view<Char, Traits>;
+    detail::chunking<Char, Traits> chunks(hay, needle.size(), chunk_size);
+    if(needle.empty() || chunks.count < 2) return hay.find(needle);
+
+    basic_searcher<Char, Traits> s(needle);
+    std::atomic<size_t> best{ view_type::npos };
+    detail::parallel_chunks(executor, chunks.count, [&](size_t ix) {
+        // a match further left has been found already
+        if(ix * chunks.size >= best) return;
+        auto found = chunks.region(ix).find(s);
+        if(found == view_type::npos) return;
+        found += ix * chunks.size;
+        auto current = best.load();
+        while(found < current && !best.compare_exchange_weak(current, found)) {}
+    });
+    return best;
+}
+
+template<class Char, class Traits, class Executor>
+std::vector<typename basic_string_view<Char, Traits>::size_type>
+parallel_find_all(basic_string_view<Char, Traits> hay, typename detail::identity<basic_string_view<Char, Traits>>::type needle,
+                  Executor& executor, size_t chunk_size = 0) {
+    using view_type = basic_string_view<Char, Traits>;
+    using size_type = typename view_type::size_type;
+    std::vector<size_type> res;
+    if(needle.empty() || needle.size() > hay.size()) return res;
+
+    basic_searcher<Char, Traits> s(needle);
+    detail::chunking<Char, Traits> chunks(hay, needle.size(), chunk_size);
+    std::vector<std::vector<size_type>> found(chunks.count);
+    auto search = [&](size_t ix) {
+        auto region = chunks.region(ix);
+        auto offset = ix * chunks.size;
+        for(auto pos = region.find(s); pos != view_type::npos; pos = region.find(s, pos + 1))
+            found[ix].push_back(offset + pos);
+    };
+    if(chunks.count < 2) search(0);
+    else detail::parallel_chunks(executor, chunks.count, search);
+
+    size_t total = 0;
+    for(auto&& part : found) total += part.size();
+    res.reserve(total);
+    for(auto&& part : found) res.insert(res.end(), part.begin(), part.end());
+    return res;
+}
+
+template<class Char, class Traits, class Executor>
+size_t parallel_count(basic_string_view<Char, Traits> hay, typename detail::identity<basic_string_view<Char, Traits>>::type needle,
+                      Executor& executor, size_t chunk_size = 0) {
+    using view_type = basic_string_view<Char, Traits>;
+    if(needle.empty() || needle.size() > hay.size()) return 0;
+
+    basic_searcher<Char, Traits> s(needle);
+    detail::chunking<Char, Traits> chunks(hay, needle.size(), chunk_size);
+    std::vector<size_t> counts(chunks.count);
+    auto search = [&](size_t ix) {
+        auto region = chunks.region(ix);
+        size_t count = 0;
+        for(auto pos = region.find(s); pos != view_type::npos; pos = region.find(s, pos + 1)) ++count;
+        counts[ix] = count;
+    };
+    if(chunks.count < 2) search(0);
+    else detail::parallel_chunks(executor, chunks.count, search);
+
+    size_t total = 0;
+    for(auto count : counts) total += count;
+    return total;
+}
+
+// the same on thread_pool::shared()
+template<class Char, class Traits>
+typename basic_string_view<Char, Traits>::size_type
+parallel_find(basic_string_view<Char, Traits> hay, typename detail::identity<basic_string_view<Char, Traits>>::type needle) {
+    return parallel_find(hay, needle, thread_pool::shared());
+}
+template<class Char, class Traits>
+std::vector<typename basic_string_view<Char, Traits>::size_type>
+parallel_find_all(basic_string_view<Char, Traits> hay, typename detail::identity<basic_string_view<Char, Traits>>::type needle) {
+    return parallel_find_all(hay, needle, thread_pool::shared());
+}
+template<class Char, class Traits>
+size_t parallel_count(basic_string_view<Char, Traits> hay, typename detail::identity<basic_string_view<Char, Traits>>::type needle) {
+    return parallel_count(hay, needle, thread_pool::shared());
+}
+
+// single characters
+template<class Char, class Traits, class Executor>
+typename basic_string_view<Char, Traits>::size_type
+parallel_find(basic_string_view<Char, Traits> hay, typename detail::identity<Char>::type needle, Executor& executor, size_t chunk_size = 0) {
+    return parallel_find(hay, basic_string_view<Char, Traits>(&needle, 1), executor, chunk_size);
+}
+template<class Char, class Traits, class Executor>
+std::vector<typename basic_string_view<Char, Traits>::size_type>
+parallel_find_all(basic_string_view<Char, Traits> hay, typename detail::identity<Char>::type needle, Executor& executor, size_t chunk_size = 0) {
+    return parallel_find_all(hay, basic_string_view<Char, Traits>(&needle, 1), executor, chunk_size);
+}
+template<class Char, class Traits, class Executor>
+size_t parallel_count(basic_string_view<Char, Traits> hay, typename detail::identity<Char>::type needle, Executor& executor, size_t chunk_size = 0) {
+    return parallel_count(hay, basic_string_view<Char, Traits>(&needle, 1), executor, chunk_size);
+}
+template<class Char, class Traits>
+typename basic_string_view<Char, Traits>::size_type
+parallel_find(basic_string_view<Char, Traits> hay, typename detail::identity<Char>::type needle) {
+    return parallel_find(hay, needle, thread_pool::shared());
+}
+template<class Char, class Traits>
+std::vector<typename basic_string_view<Char, Traits>::size_type>
+parallel_find_all(basic_string_view<Char, Traits> hay, typename detail::identity<Char>::type needle) {
+    return parallel_find_all(hay, needle, thread_pool::shared());
+}
+template<class Char, class Traits>
+size_t parallel_count(basic_string_view<Char, Traits> hay, typename detail::identity<Char>::type needle) {
+    return parallel_count(hay, needle, thread_pool::shared());
+}
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_PARALLEL_HPP */
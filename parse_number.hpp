@@ -0,0 +1,521 @@
+#ifndef ESSENTIALS_PARSE_NUMBER_HPP
+#define ESSENTIALS_PARSE_NUMBER_HPP
+
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include <locale.h>
+#include <stdlib.h>
+#ifdef __APPLE__
+#   include <xlocale.h>
+#endif
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+enum class parse_errc { ok, invalid, out_of_range };
+
+template<class T>
+struct parse_result {
+    T value;
+    // characters making up the number, 0 if there is none
+    size_t consumed;
+    parse_errc error;
+
+    explicit operator bool() const noexcept { return error == parse_errc::ok; }
+};
+
+namespace detail {
+
+inline bool is_digit(char c) noexcept { return unsigned(c - '0') < 10; }
+
+// 8 characters as a little-endian word
+inline uint64_t read_digits(const char* p) noexcept {
+    uint64_t word;
+    std::memcpy(&word, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+inline bool is_8_digits(uint64_t word) noexcept {
+    return ((word & 0xF0F0F0F0F0F0F0F0) | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+        == 0x3333333333333333;
+}
+
+// the value of 8 decimal digits, first digit in the lowest byte
+inline uint32_t parse_8_digits(uint64_t word) noexcept {
+    const uint64_t mask = 0x000000FF000000FF;
+    const uint64_t mul1 = 0x000F424000000064; // 100 + (1000000 << 32)
+    const uint64_t mul2 = 0x0000271000000001; // 1 + (10000 << 32)
+    word -= 0x3030303030303030;
+    word = (word * 10) + (word >> 8);
+    word = (((word & mask) * mul1) + (((word >> 16) & mask) * mul2)) >> 32;
+    return uint32_t(word);
+}
+
+// folds the digits at `p` into `acc`, 16 and 8 at a time where it can; sets `overflow` when acc wraps
+inline const char* accumulate_decimal(const char* p, const char* end, uint64_t& acc, bool& overflow) noexcept {
+    while(end - p >= 16) {
+        auto high = read_digits(p), low = read_digits(p + 8);
+        if(!is_8_digits(high) || !is_8_digits(low)) break;
+        auto block = uint64_t(parse_8_digits(high)) * 100000000 + parse_8_digits(low);
+        if(__builtin_mul_overflow(acc, uint64_t(10000000000000000), &acc) || __builtin_add_overflow(acc, block, &acc))
+            overflow = true;
+        p += 16;
+    }
+    if(end - p >= 8) {
+        auto word = read_digits(p);
+        if(is_8_digits(word)) {
+            if(__builtin_mul_overflow(acc, uint64_t(100000000), &acc)
+                || __builtin_add_overflow(acc, uint64_t(parse_8_digits(word)), &acc))
+                overflow = true;
+            p += 8;
+        }
+    }
+    for(; p != end && is_digit(*p); ++p)
+        if(__builtin_mul_overflow(acc, uint64_t(10), &acc) || __builtin_add_overflow(acc, uint64_t(*p - '0'), &acc))
+            overflow = true;
+    return p;
+}
+
+// the same with wrapping arithmetic, for float mantissas that get re-read when they are too long
+inline const char* accumulate_mantissa(const char* p, const char* end, uint64_t& acc) noexcept {
+    for(; end - p >= 8; p += 8) {
+        auto word = read_digits(p);
+        if(!is_8_digits(word)) break;
+        acc = acc * 100000000 + parse_8_digits(word);
+    }
+    for(; p != end && is_digit(*p); ++p) acc = acc * 10 + uint64_t(*p - '0');
+    return p;
+}
+
+inline unsigned digit_value(char c) noexcept {
+    if(c >= '0' && c <= '9') return unsigned(c - '0');
+    if(c >= 'a' && c <= 'z') return unsigned(c - 'a' + 10);
+    if(c >= 'A' && c <= 'Z') return unsigned(c - 'A' + 10);
+    return 36;
+}
+
+inline const char* accumulate_digits(const char* p, const char* end, unsigned base, uint64_t& acc, bool& overflow) noexcept {
+    for(; p != end; ++p) {
+        auto digit = digit_value(*p);
+        if(digit >= base) break;
+        if(__builtin_mul_overflow(acc, uint64_t(base), &acc) || __builtin_add_overflow(acc, uint64_t(digit), &acc))
+            overflow = true;
+    }
+    return p;
+}
+
+/*
+ * Eisel-Lemire: the binary float nearest to w * 10^q, from w times a 128-bit approximation of 5^q.
+ * The approximations are truncated 5^q for q >= 0 and 2^b / 5^-q rounded up for q < 0,
+ * normalized to a set top bit; they are computed once on first use instead of being spelled out here.
+ */
+struct powers_of_five {
+    static constexpr int smallest = -342;
+    static constexpr int largest = 308;
+
+    uint64_t table[2 * (largest - smallest + 1)];
+
+    static const powers_of_five& get() {
+        static const powers_of_five powers;
+        return powers;
+    }
+
+    // the 128-bit approximation of 5^q, high word first
+    const uint64_t* operator[](int q) const noexcept { return table + 2 * (q - smallest); }
+
+private:
+    // just enough of a bignum for the table: little-endian 32-bit limbs, room for 2^1791
+    struct wide {
+        static constexpr size_t limbs = 56;
+        uint32_t data[limbs] = {};
+
+        void multiply(uint32_t m) noexcept {
+            uint64_t carry = 0;
+            for(auto&& l : data) {
+                carry += uint64_t(l) * m;
+                l = uint32_t(carry);
+                carry >>= 32;
+            }
+        }
+        void divide(uint32_t d) noexcept {
+            uint64_t rest = 0;
+            for(size_t ix = limbs; ix-- > 0;) {
+                auto current = (rest << 32) | data[ix];
+                data[ix] = uint32_t(current / d);
+                rest = current % d;
+            }
+        }
+        void add_one() noexcept {
+            for(auto&& l : data)
+                if(++l != 0) break;
+        }
+        void shift_right(size_t count) noexcept {
+            for(size_t ix = 0; ix < limbs * 32; ++ix) set(ix, bit(ix + count));
+        }
+        size_t bits() const noexcept {
+            for(size_t ix = limbs; ix-- > 0;)
+                if(data[ix] != 0) return ix * 32 + 32 - size_t(__builtin_clz(data[ix]));
+            return 0;
+        }
+        bool bit(size_t ix) const noexcept { return ix < limbs * 32 && ((data[ix / 32] >> (ix % 32)) & 1); }
+        void set(size_t ix, bool value) noexcept {
+            if(value) data[ix / 32] |= uint32_t(1) << (ix % 32);
+            else data[ix / 32] &= ~(uint32_t(1) << (ix % 32));
+        }
+        // the top 128 bits, shifted up to fill them if there are fewer
+        void top(uint64_t* out) const noexcept {
+            auto from = ptrdiff_t(bits()) - 128;
+            out[0] = out[1] = 0;
+            for(ptrdiff_t ix = 127; ix >= 0; --ix) {
+                auto at = from + ix;
+                auto b = at >= 0 && bit(size_t(at));
+                out[ix >= 64? 0 : 1] |= uint64_t(b) << (ix % 64);
+            }
+        }
+    };
+
+    powers_of_five() noexcept {
+        wide power;
+        power.data[0] = 1;
+        for(int q = 0; q <= largest; ++q, power.multiply(5)) power.top(table + 2 * (q - smallest));
+
+        // floor(2^b / 5^k) for every b the table needs is a shift of floor(2^total / 5^k)
+        const size_t total = 1718;
+        wide quotient;
+        quotient.set(total, true);
+        power = wide();
+        power.data[0] = 1;
+        for(int k = 1; k <= -smallest; ++k) {
+            power.multiply(5);
+            quotient.divide(5);
+            auto z = power.bits();
+            auto b = (k <= 27)? z + 127 : 2 * z + 128;
+            auto c = quotient;
+            c.shift_right(total - b);
+            c.add_one();
+            c.top(table + 2 * (-k - smallest));
+        }
+    }
+};
+
+template<class T>
+struct float_format;
+
+template<>
+struct float_format<double> {
+    using bits_type = uint64_t;
+    static constexpr int mantissa_bits = 52;
+    static constexpr int minimum_exponent = -1023;
+    static constexpr int infinite_power = 0x7FF;
+    static constexpr int min_round_to_even = -4;
+    static constexpr int max_round_to_even = 23;
+    static constexpr int max_fast_exponent = 22;
+
+    static double exact_power_of_ten(int e) noexcept {
+        static const double powers[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        return powers[e];
+    }
+    static double strto(const char* text, locale_t locale) noexcept { return ::strtod_l(text, nullptr, locale); }
+};
+
+template<>
+struct float_format<float> {
+    using bits_type = uint32_t;
+    static constexpr int mantissa_bits = 23;
+    static constexpr int minimum_exponent = -127;
+    static constexpr int infinite_power = 0xFF;
+    static constexpr int min_round_to_even = -17;
+    static constexpr int max_round_to_even = 10;
+    static constexpr int max_fast_exponent = 10;
+
+    static float exact_power_of_ten(int e) noexcept {
+        static const float powers[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+        return powers[e];
+    }
+    static float strto(const char* text, locale_t locale) noexcept { return ::strtof_l(text, nullptr, locale); }
+};
+
+// a float as mantissa bits and biased exponent
+struct adjusted_mantissa {
+    uint64_t mantissa;
+    int power2;
+
+    bool operator==(const adjusted_mantissa& that) const noexcept {
+        return mantissa == that.mantissa && power2 == that.power2;
+    }
+};
+
+template<class T>
+adjusted_mantissa compute_float(int64_t q, uint64_t w) noexcept {
+    using format = float_format<T>;
+    const int mantissa_bits = format::mantissa_bits;
+    if(w == 0 || q < powers_of_five::smallest) return adjusted_mantissa{ 0, 0 };
+    if(q > powers_of_five::largest) return adjusted_mantissa{ 0, format::infinite_power };
+
+    auto lz = __builtin_clzll(w);
+    w <<= lz;
+    auto power = powers_of_five::get()[int(q)];
+    // the high word decides unless the bits below the mantissa might still carry
+    const uint64_t precision_mask = ~uint64_t(0) >> (mantissa_bits + 3);
+    // mum leaves the low half of the product in its first argument and the high half in its second
+    uint64_t low = w, high = power[0];
+    mum(low, high);
+    if((high & precision_mask) == precision_mask) {
+        uint64_t second_low = w, second = power[1];
+        mum(second_low, second);
+        low += second;
+        if(second > low) ++high;
+    }
+
+    auto upper = int(high >> 63);
+    auto shift = upper + 64 - mantissa_bits - 3;
+    adjusted_mantissa res;
+    res.mantissa = high >> shift;
+    res.power2 = int((((152170 + 65536) * int(q)) >> 16) + 63 + upper - lz - format::minimum_exponent);
+    if(res.power2 <= 0) {
+        // subnormal
+        if(-res.power2 + 1 >= 64) return adjusted_mantissa{ 0, 0 };
+        res.mantissa >>= -res.power2 + 1;
+        res.mantissa += res.mantissa & 1;
+        res.mantissa >>= 1;
+        res.power2 = (res.mantissa < (uint64_t(1) << mantissa_bits))? 0 : 1;
+        return res;
+    }
+    // exactly halfway between two floats: round to even
+    if(low <= 1 && q >= format::min_round_to_even && q <= format::max_round_to_even && (res.mantissa & 3) == 1
+        && (res.mantissa << shift) == high)
+        res.mantissa &= ~uint64_t(1);
+    res.mantissa += res.mantissa & 1;
+    res.mantissa >>= 1;
+    if(res.mantissa >= (uint64_t(2) << mantissa_bits)) {
+        res.mantissa = uint64_t(1) << mantissa_bits;
+        ++res.power2;
+    }
+    res.mantissa &= ~(uint64_t(1) << mantissa_bits);
+    if(res.power2 >= format::infinite_power) return adjusted_mantissa{ 0, format::infinite_power };
+    return res;
+}
+
+template<class T>
+T to_float(adjusted_mantissa am, bool negative) noexcept {
+    using format = float_format<T>;
+    using bits_type = typename format::bits_type;
+    auto bits = bits_type(am.mantissa) | (bits_type(am.power2) << format::mantissa_bits);
+    if(negative) bits |= bits_type(1) << (sizeof(T) * 8 - 1);
+    T res;
+    std::memcpy(&res, &bits, sizeof(T));
+    return res;
+}
+
+// strtod in the "C" locale, for the rare mantissas too long for Eisel-Lemire to settle
+template<class T>
+T parse_float_slow(const char* first, size_t size) {
+    static const locale_t c_locale = ::newlocale(LC_ALL_MASK, "C", locale_t(0));
+    std::string text(first, size);
+    return float_format<T>::strto(text.c_str(), c_locale);
+}
+
+inline bool match_lower(const char* p, const char* end, const char* lower) noexcept {
+    for(; *lower; ++p, ++lower)
+        if(p == end || (*p | 0x20) != *lower) return false;
+    return true;
+}
+
+// inf, infinity and nan, nan(chars) in any case
+template<class T>
+parse_result<T> parse_float_special(const char* first, const char* p, const char* end, bool negative) noexcept {
+    if(match_lower(p, end, "inf")) {
+        p += match_lower(p, end, "infinity")? 8 : 3;
+        auto value = negative? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+        return parse_result<T>{ value, size_t(p - first), parse_errc::ok };
+    }
+    if(match_lower(p, end, "nan")) {
+        p += 3;
+        if(p != end && *p == '(') {
+            auto close = p + 1;
+            while(close != end && (digit_value(*close) < 36 || *close == '_')) ++close;
+            if(close != end && *close == ')') p = close + 1;
+        }
+        auto value = negative? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+        return parse_result<T>{ value, size_t(p - first), parse_errc::ok };
+    }
+    return parse_result<T>{ T(0), 0, parse_errc::invalid };
+}
+
+} /* namespace detail */
+
+/*
+ * Parses an integer at the start of `s` the way std::from_chars does:
+ * an optional '-' for signed types, then digits in `base` (2 to 36), no whitespace, no '+', no "0x".
+ * Decimal digits go 16 and 8 at a time through SWAR arithmetic.
+ * A number that does not fit in T is consumed whole and reported as out_of_range with a zero value.
+ */
+template<class T>
+parse_result<T> parse_int(string_view s, int base = 10) noexcept {
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value, "parse_int parses integers");
+    using unsigned_type = typename std::make_unsigned<T>::type;
+
+    auto first = s.data(), end = first + s.size(), p = first;
+    if(base < 2 || base > 36) return parse_result<T>{ T(0), 0, parse_errc::invalid };
+    bool negative = std::is_signed<T>::value && p != end && *p == '-';
+    if(negative) ++p;
+
+    uint64_t acc = 0;
+    bool overflow = false;
+    auto digits = p;
+    p = (base == 10)? detail::accumulate_decimal(p, end, acc, overflow)
+        : detail::accumulate_digits(p, end, unsigned(base), acc, overflow);
+    if(p == digits) return parse_result<T>{ T(0), 0, parse_errc::invalid };
+
+    auto consumed = size_t(p - first);
+    auto limit = uint64_t(std::numeric_limits<T>::max()) + (negative? 1 : 0);
+    if(overflow || acc > limit) return parse_result<T>{ T(0), consumed, parse_errc::out_of_range };
+    auto value = negative? T(unsigned_type(0) - unsigned_type(acc)) : T(acc);
+    return parse_result<T>{ value, consumed, parse_errc::ok };
+}
+
+/*
+ * Parses a float or a double at the start of `s` the way std::from_chars with chars_format::general does:
+ * an optional '-', digits with an optional '.', an optional exponent, or inf/infinity/nan.
+ * The result is the correctly rounded nearest value, independent of the locale.
+ * Up to 19 significant digits go through Eisel-Lemire (or straight float arithmetic when that is exact);
+ * longer mantissas only fall back to strtod_l when their first 19 digits leave the rounding open.
+ * Values too large or too small for T are out_of_range, with an infinity or a zero of the right sign.
+ */
+template<class T>
+parse_result<T> parse_float(string_view s) {
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value, "parse_float parses float or double");
+    using format = detail::float_format<T>;
+
+    auto first = s.data(), end = first + s.size(), p = first;
+    bool negative = p != end && *p == '-';
+    if(negative) ++p;
+    if(p != end && !detail::is_digit(*p) && *p != '.') return detail::parse_float_special<T>(first, p, end, negative);
+
+    uint64_t w = 0;
+    auto int_first = p;
+    p = detail::accumulate_mantissa(p, end, w);
+    auto int_last = p;
+    auto frac_first = p, frac_last = p;
+    if(p != end && *p == '.') {
+        frac_first = ++p;
+        p = detail::accumulate_mantissa(p, end, w);
+        frac_last = p;
+    }
+    int64_t digits = (int_last - int_first) + (frac_last - frac_first);
+    if(digits == 0) return parse_result<T>{ T(0), 0, parse_errc::invalid };
+    int64_t exponent = frac_first - frac_last;
+
+    int64_t explicit_exponent = 0;
+    if(p != end && (*p | 0x20) == 'e') {
+        auto mark = p++;
+        bool negative_exponent = false;
+        if(p != end && (*p == '-' || *p == '+')) negative_exponent = *p++ == '-';
+        if(p == end || !detail::is_digit(*p)) p = mark;
+        else {
+            for(; p != end && detail::is_digit(*p); ++p)
+                if(explicit_exponent < 0x10000000) explicit_exponent = explicit_exponent * 10 + (*p - '0');
+            if(negative_exponent) explicit_exponent = -explicit_exponent;
+            exponent += explicit_exponent;
+        }
+    }
+    auto consumed = size_t(p - first);
+
+    // more than 19 significant digits: keep the first 19
+    bool truncated = false;
+    if(digits > 19) {
+        for(auto q = int_first; q != frac_last && (*q == '0' || *q == '.'); ++q)
+            if(*q == '0') --digits;
+        if(digits > 19) {
+            truncated = true;
+            const uint64_t nineteen_digits = 1000000000000000000;
+            w = 0;
+            auto q = int_first;
+            for(; w < nineteen_digits && q != int_last; ++q) w = w * 10 + uint64_t(*q - '0');
+            if(w >= nineteen_digits) exponent = (int_last - q) + explicit_exponent;
+            else {
+                for(q = frac_first; w < nineteen_digits && q != frac_last; ++q) w = w * 10 + uint64_t(*q - '0');
+                exponent = (frac_first - q) + explicit_exponent;
+            }
+        }
+    }
+
+    T value;
+#if FLT_EVAL_METHOD == 0
+    // both operands exact, so is the one rounding
+    if(!truncated && exponent >= -format::max_fast_exponent && exponent <= format::max_fast_exponent
+        && w <= (uint64_t(2) << format::mantissa_bits)) {
+        value = T(w);
+        if(exponent < 0) value = value / format::exact_power_of_ten(int(-exponent));
+        else value = value * format::exact_power_of_ten(int(exponent));
+        if(negative) value = -value;
+        return parse_result<T>{ value, consumed, parse_errc::ok };
+    }
+#endif
+    auto am = detail::compute_float<T>(exponent, w);
+    if(truncated && !(am == detail::compute_float<T>(exponent, w + 1))) value = detail::parse_float_slow<T>(first, consumed);
+    else value = detail::to_float<T>(am, negative);
+
+    bool out_of_range = (value == 0 && w != 0) || value == std::numeric_limits<T>::infinity()
+        || value == -std::numeric_limits<T>::infinity();
+    return parse_result<T>{ value, consumed, out_of_range? parse_errc::out_of_range : parse_errc::ok };
+}
+
+// parse_int or parse_float, by T
+template<class T>
+typename std::enable_if<std::is_integral<T>::value, parse_result<T>>::type parse_number(string_view s) noexcept {
+    return parse_int<T>(s);
+}
+template<class T>
+typename std::enable_if<std::is_floating_point<T>::value, parse_result<T>>::type parse_number(string_view s) {
+    return parse_float<T>(s);
+}
+
+struct parse_batch_result {
+    // numbers written out
+    size_t count;
+    // characters up to the end of the last number written
+    size_t consumed;
+    // ok unless a field that should have held a number did not
+    parse_errc error;
+};
+
+/*
+ * Parses a run of `delimiter`-separated numbers into `out`, as in one CSV row or a one-column file:
+ * stops after `limit` numbers, at the end of `s` or after a number not followed by the delimiter
+ * (a line end, say), which then sits at `consumed`.
+ * A field that does not start with a number stops the run with its error.
+ */
+template<class T, class OutputIt>
+parse_batch_result parse_delimited(string_view s, char delimiter, OutputIt out, size_t limit = string_view::npos) {
+    parse_batch_result res{ 0, 0, parse_errc::ok };
+    for(size_t position = 0; res.count < limit; ++position) {
+        auto number = parse_number<T>(s.substr(position));
+        if(!number) {
+            res.error = number.error;
+            break;
+        }
+        *out++ = number.value;
+        ++res.count;
+        position += number.consumed;
+        res.consumed = position;
+        if(position == s.size() || s[position] != delimiter) break;
+    }
+    return res;
+}
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_PARSE_NUMBER_HPP */
@@ -0,0 +1,246 @@
+#ifndef ESSENTIALS_PREFIX_INDEX_HPP
+#define ESSENTIALS_PREFIX_INDEX_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+/*
+ * Longest-prefix matching over a fixed set of keys: a compressed radix trie in one array.
+ * Siblings are adjacent and the first code unit of each edge sits in a parallel array,
+ * so picking a child is one Traits::find over a few bytes and a lookup touches a node per branch.
+ * Keys are copied into the index and kept sorted, so the keys under any node form one contiguous run;
+ * that is what with_prefix returns. Building is a sort plus one linear pass, cheap enough to redo on reload.
+ * Of duplicate keys the first one wins.
+ */
+template<class Value, class Char = char, class Traits = std::char_traits<Char>>
+class basic_prefix_index {
+public:
+    using view_type = basic_string_view<Char, Traits>;
+    using item_type = std::pair<view_type, Value>;
+    using const_iterator = const item_type*;
+
+    // the items whose keys start with some prefix, in key order
+    struct item_range {
+        const item_type* first = nullptr;
+        const item_type* last = nullptr;
+
+        const item_type* begin() const noexcept { return first; }
+        const item_type* end() const noexcept { return last; }
+        size_t size() const noexcept { return size_t(last - first); }
+        bool empty() const noexcept { return first == last; }
+    };
+
+private:
+    static constexpr uint32_t none = ~uint32_t(0);
+
+    struct node {
+        // the edge leading here, as an offset into pool_
+        uint32_t label;
+        uint32_t label_size;
+        uint32_t first_child;
+        uint32_t child_count;
+        // the item whose key ends here, or none
+        uint32_t item;
+        // the items below: [first_item, last_item)
+        uint32_t first_item;
+        uint32_t last_item;
+    };
+
+    std::basic_string<Char, Traits> pool_;
+    std::vector<item_type> items_;
+    std::vector<node> nodes_;
+    // the first code unit of every node's label, next to its siblings'
+    std::vector<Char> edges_;
+
+    size_t child_of(const node& n, Char c) const noexcept {
+        auto found = Traits::find(edges_.data() + n.first_child, n.child_count, c);
+        return found? size_t(found - edges_.data()) : size_t(none);
+    }
+
+    struct build_task {
+        size_t node;
+        size_t lo;
+        size_t hi;
+        size_t depth;
+    };
+
+    // lays out the nodes below the root, depth first; the explicit stack keeps long nested keys off the call stack
+    void build() {
+        std::vector<build_task> stack{ build_task{ 0, 0, items_.size(), 0 } };
+        std::vector<std::pair<size_t, size_t>> groups;
+        while(!stack.empty()) {
+            auto task = stack.back();
+            stack.pop_back();
+            auto ix = task.node, lo = task.lo, hi = task.hi, depth = task.depth;
+            nodes_[ix].first_item = uint32_t(lo);
+            nodes_[ix].last_item = uint32_t(hi);
+            // sorted, so a key equal to the path comes first
+            if(lo < hi && items_[lo].first.size() == depth) nodes_[ix].item = uint32_t(lo++);
+
+            groups.clear();
+            for(auto g = lo; g < hi;) {
+                auto c = items_[g].first[depth];
+                auto e = g + 1;
+                while(e < hi && Traits::eq(items_[e].first[depth], c)) ++e;
+                groups.emplace_back(g, e);
+                g = e;
+            }
+
+            auto first_child = nodes_.size();
+            nodes_[ix].first_child = uint32_t(first_child);
+            nodes_[ix].child_count = uint32_t(groups.size());
+            nodes_.resize(first_child + groups.size(), node{ 0, 0, 0, 0, none, 0, 0 });
+            edges_.resize(nodes_.size());
+
+            // pushed last to first, so that they come off the stack in key order
+            for(auto k = groups.size(); k-- > 0;) {
+                auto front = items_[groups[k].first].first;
+                auto back = items_[groups[k].second - 1].first;
+                // the group shares whatever its first and last keys share
+                auto common = depth + 1;
+                auto limit = std::min(front.size(), back.size());
+                while(common < limit && Traits::eq(front[common], back[common])) ++common;
+
+                auto child = first_child + k;
+                nodes_[child].label = uint32_t(front.data() + depth - pool_.data());
+                nodes_[child].label_size = uint32_t(common - depth);
+                edges_[child] = front[depth];
+                stack.push_back(build_task{ child, groups[k].first, groups[k].second, common });
+            }
+        }
+    }
+
+    // calls `visit(node)` for the root and every node on the path spelled by a prefix of `key`
+    template<class F>
+    void walk(view_type key, F&& visit) const {
+        if(nodes_.empty()) return;
+        size_t ix = 0, pos = 0;
+        while(true) {
+            visit(nodes_[ix]);
+            if(pos == key.size()) return;
+            auto child = child_of(nodes_[ix], key[pos]);
+            if(child == none) return;
+            auto&& n = nodes_[child];
+            if(key.size() - pos < n.label_size
+                || Traits::compare(key.data() + pos, pool_.data() + n.label, n.label_size) != 0) return;
+            pos += n.label_size;
+            ix = child;
+        }
+    }
+
+    // points the item views at pool_, which holds the keys back to back
+    void rebase() noexcept {
+        size_t offset = 0;
+        for(auto&& item : items_) {
+            item.first = view_type(pool_.data() + offset, item.first.size());
+            offset += item.first.size();
+        }
+    }
+
+public:
+    basic_prefix_index() = default;
+
+    // from a range of pairs of something convertible to a view and a value
+    template<class It>
+    basic_prefix_index(It first, It last) {
+        for(; first != last; ++first) items_.emplace_back(view_type(first->first), first->second);
+        std::stable_sort(items_.begin(), items_.end(),
+            [](const item_type& lhv, const item_type& rhv) { return lhv.first < rhv.first; });
+        items_.erase(std::unique(items_.begin(), items_.end(),
+            [](const item_type& lhv, const item_type& rhv) { return lhv.first == rhv.first; }), items_.end());
+
+        size_t total = 0;
+        for(auto&& item : items_) total += item.first.size();
+        if(total >= none || items_.size() >= none) throw std::length_error("prefix_index: too many keys");
+        pool_.reserve(total);
+        for(auto&& item : items_) pool_.append(item.first.data(), item.first.size());
+        rebase();
+
+        nodes_.push_back(node{ 0, 0, 0, 0, none, 0, 0 });
+        edges_.push_back(Char());
+        build();
+    }
+    basic_prefix_index(std::initializer_list<item_type> items): basic_prefix_index(items.begin(), items.end()) {}
+
+    // a copied or moved string may keep its characters elsewhere (the short buffer), so the views are redone
+    basic_prefix_index(const basic_prefix_index& that):
+        pool_(that.pool_), items_(that.items_), nodes_(that.nodes_), edges_(that.edges_) { rebase(); }
+    basic_prefix_index(basic_prefix_index&& that) noexcept:
+        pool_(std::move(that.pool_)), items_(std::move(that.items_)),
+        nodes_(std::move(that.nodes_)), edges_(std::move(that.edges_)) { rebase(); }
+    basic_prefix_index& operator=(basic_prefix_index that) noexcept {
+        swap(that);
+        return *this;
+    }
+    void swap(basic_prefix_index& that) noexcept {
+        pool_.swap(that.pool_);
+        items_.swap(that.items_);
+        nodes_.swap(that.nodes_);
+        edges_.swap(that.edges_);
+        rebase();
+        that.rebase();
+    }
+
+    size_t size() const noexcept { return items_.size(); }
+    bool empty() const noexcept { return items_.empty(); }
+    const_iterator begin() const noexcept { return items_.data(); }
+    const_iterator end() const noexcept { return items_.data() + items_.size(); }
+
+    // the item with the longest key that `key` starts with, nullptr if there is none
+    const item_type* longest_prefix(view_type key) const {
+        const item_type* res = nullptr;
+        walk(key, [&](const node& n) { if(n.item != none) res = &items_[n.item]; });
+        return res;
+    }
+
+    // calls `f(item)` for every item whose key `key` starts with, shortest first
+    template<class F>
+    void for_each_prefix(view_type key, F&& f) const {
+        walk(key, [&](const node& n) { if(n.item != none) f(items_[n.item]); });
+    }
+
+    std::vector<const item_type*> all_prefixes(view_type key) const {
+        std::vector<const item_type*> res;
+        for_each_prefix(key, [&](const item_type& item) { res.push_back(&item); });
+        return res;
+    }
+
+    // the items whose keys start with `prefix`
+    item_range with_prefix(view_type prefix) const {
+        if(nodes_.empty()) return item_range{};
+        size_t ix = 0, pos = 0;
+        while(pos < prefix.size()) {
+            auto child = child_of(nodes_[ix], prefix[pos]);
+            if(child == none) return item_range{};
+            auto&& n = nodes_[child];
+            // the prefix may end halfway along an edge
+            auto count = std::min<size_t>(n.label_size, prefix.size() - pos);
+            if(Traits::compare(prefix.data() + pos, pool_.data() + n.label, count) != 0) return item_range{};
+            pos += count;
+            ix = child;
+        }
+        return item_range{ begin() + nodes_[ix].first_item, begin() + nodes_[ix].last_item };
+    }
+
+    // the item with exactly this key, nullptr if there is none
+    const item_type* find(view_type key) const {
+        auto range = with_prefix(key);
+        return (!range.empty() && range.first->first.size() == key.size())? range.first : nullptr;
+    }
+};
+
+template<class Value, class Char, class Traits>
+constexpr uint32_t basic_prefix_index<Value, Char, Traits>::none;
+
+template<class Value>
+using prefix_index = basic_prefix_index<Value, char>;
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_PREFIX_INDEX_HPP */
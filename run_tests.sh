@@ -2,4 +2,4 @@
 
 rm -rf tests/build/
 mkdir tests/build
-(cd tests/build && cmake .. && make && ./string_view_tests)
\ No newline at end of file
+(cd tests/build && cmake .. && make && ./string_view_tests && ./string_view_instrumented_tests)
\ No newline at end of file
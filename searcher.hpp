@@ -0,0 +1,113 @@
+#ifndef ESSENTIALS_SEARCHER_HPP
+#define ESSENTIALS_SEARCHER_HPP
+
+#include <vector>
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+/*
+ * A needle compiled once for repeated searches.
+ * The strategy is picked on construction:
+ *  - short needles use the SIMD anchor prefilter of basic_string_view::find;
+ *  - medium needles over narrow plain characters use a Horspool skip table;
+ *  - everything longer (or wider) uses a precomputed Two-Way factorization.
+ * The needle is not copied and has to outlive the searcher.
+ * Results are the same as basic_string_view::find(needle, pos).
+ */
+template<class Char, class Traits = std::char_traits<Char>>
+class basic_searcher {
+public:
+    using view_type = basic_string_view<Char, Traits>;
+    using size_type = typename view_type::size_type;
+
+    static constexpr size_type prefilter_limit = detail::scalar_kernels<Char, Traits>::two_way_threshold;
+    static constexpr size_type horspool_limit = 256;
+
+private:
+    enum class strategy { prefilter, horspool, two_way };
+
+    view_type needle_;
+    strategy strategy_ = strategy::prefilter;
+    std::vector<uint32_t> shift_;
+    detail::two_way<Char, Traits> two_way_;
+
+    static constexpr bool horspool_applies() noexcept {
+        return sizeof(Char) == 1 && detail::is_plain_traits<Char, Traits>::value;
+    }
+
+    const Char* horspool(const Char* hay, size_t n) const noexcept {
+        auto m = needle_.size();
+        auto needle = needle_.data();
+        auto last = needle[m - 1];
+        for(size_t j = 0; j + m <= n;) {
+            auto c = hay[j + m - 1];
+            if(Traits::eq(c, last) && Traits::compare(hay + j, needle, m - 1) == 0) return hay + j;
+            j += shift_[static_cast<unsigned char>(c)];
+        }
+        return nullptr;
+    }
+
+public:
+    explicit basic_searcher(view_type needle): needle_(needle) {
+        auto m = needle_.size();
+        if(m <= prefilter_limit) return;
+        if(horspool_applies() && m <= horspool_limit) {
+            strategy_ = strategy::horspool;
+            shift_.assign(256, uint32_t(m));
+            for(size_t ix = 0; ix + 1 < m; ++ix)
+                shift_[static_cast<unsigned char>(needle_[ix])] = uint32_t(m - 1 - ix);
+            return;
+        }
+        strategy_ = strategy::two_way;
+        two_way_ = detail::two_way<Char, Traits>(needle_.data(), m);
+    }
+
+    view_type needle() const noexcept { return needle_; }
+
+    // position of the needle in `hay` at or after `pos`, npos if there is none
+    size_type operator()(view_type hay, size_type pos = 0) const noexcept {
+        auto m = needle_.size();
+        if(pos >= hay.size()) return view_type::npos;
+        if(m == 0) return pos;
+        if(m > hay.size() - pos) return view_type::npos;
+        auto first = hay.data() + pos;
+        auto n = hay.size() - pos;
+        const Char* found = nullptr;
+        switch(strategy_) {
+        case strategy::prefilter:
+            found = detail::kernels<Char, Traits>::find(first, n, needle_.data(), m);
+            break;
+        case strategy::horspool:
+            found = horspool(first, n);
+            break;
+        case strategy::two_way:
+            found = two_way_.find(first, n);
+            break;
+        }
+        return (found == nullptr)? view_type::npos : size_type(found - hay.data());
+    }
+};
+
+template<class Char, class Traits>
+constexpr typename basic_searcher<Char, Traits>::size_type basic_searcher<Char, Traits>::prefilter_limit;
+template<class Char, class Traits>
+constexpr typename basic_searcher<Char, Traits>::size_type basic_searcher<Char, Traits>::horspool_limit;
+
+template<class Char, class Traits>
+auto basic_string_view<Char, Traits>::find(const basic_searcher<Char, Traits>& searcher, size_type pos) const noexcept -> size_type {
+    return searcher(*this, pos);
+}
+
+template<class Char, class Traits>
+basic_searcher<Char, Traits> make_searcher(basic_string_view<Char, Traits> needle) {
+    return basic_searcher<Char, Traits>(needle);
+}
+
+using searcher = basic_searcher<char>;
+using wsearcher = basic_searcher<wchar_t>;
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_SEARCHER_HPP */
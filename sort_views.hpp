@@ -0,0 +1,266 @@
+#ifndef ESSENTIALS_SORT_VIEWS_HPP
+#define ESSENTIALS_SORT_VIEWS_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+namespace detail {
+
+// a view with the next 8 bytes of its content cached as a big-endian integer
+template<class View>
+struct sort_entry {
+    uint64_t key;
+    View view;
+};
+
+// bytes [depth, depth + 8) of the view, zero-padded past its end, so keys order like the bytes do
+template<class View>
+inline uint64_t prefix_key(const View& v, size_t depth) noexcept {
+    auto data = reinterpret_cast<const unsigned char*>(v.data()) + depth;
+    if(v.size() >= depth + 8) {
+        uint64_t key;
+        std::memcpy(&key, data, 8);
+        return __builtin_bswap64(key);
+    }
+    uint64_t key = 0;
+    auto left = v.size() - depth;
+    for(size_t ix = 0; ix < 8; ++ix) key = (key << 8) | (ix < left? data[ix] : 0u);
+    return key;
+}
+
+/*
+ * MSD radix sort over cached prefix keys, one key byte per pass.
+ * Once all eight bytes of a bucket agree the views ending inside them go first (shortest first)
+ * and the keys of the rest are reloaded 8 bytes further.
+ * Small buckets fall back to a comparison sort on key, then on the remaining content.
+ * Every pass scatters in order, so with Stable the whole sort is stable.
+ */
+template<class View, bool Stable>
+class msd_radix_sorter {
+    using entry = sort_entry<View>;
+
+    entry* data_;
+    entry* scratch_;
+
+public:
+    static constexpr size_t small_limit = 64;
+
+    struct range {
+        size_t first;
+        size_t size;
+        size_t depth;
+        unsigned byte;
+    };
+
+    msd_radix_sorter(entry* data, entry* scratch) noexcept: data_(data), scratch_(scratch) {}
+
+    // sorts `r`, handing every bucket it splits off to `spawn(range)`
+    template<class Spawn>
+    void step(range r, Spawn&& spawn) const {
+        while(true) {
+            auto first = data_ + r.first;
+            if(r.size <= small_limit) {
+                small_sort(first, r.size, r.depth);
+                return;
+            }
+            if(r.byte == 8) {
+                auto ended = split_ended(r);
+                r.first += ended;
+                r.size -= ended;
+                r.depth += 8;
+                r.byte = 0;
+                for(size_t ix = r.first; ix < r.first + r.size; ++ix)
+                    data_[ix].key = prefix_key(data_[ix].view, r.depth);
+                continue;
+            }
+
+            auto shift = 56 - 8 * r.byte;
+            size_t counts[256] = {};
+            for(size_t ix = 0; ix < r.size; ++ix) ++counts[(first[ix].key >> shift) & 0xFF];
+            // a shared byte needs no scatter
+            if(counts[(first->key >> shift) & 0xFF] == r.size) {
+                ++r.byte;
+                continue;
+            }
+
+            size_t offsets[256];
+            size_t offset = 0;
+            for(size_t b = 0; b < 256; ++b) {
+                offsets[b] = offset;
+                offset += counts[b];
+            }
+            auto scratch = scratch_ + r.first;
+            for(size_t ix = 0; ix < r.size; ++ix) scratch[offsets[(first[ix].key >> shift) & 0xFF]++] = first[ix];
+            std::copy(scratch, scratch + r.size, first);
+
+            offset = r.first;
+            for(size_t b = 0; b < 256; ++b) {
+                if(counts[b] > 1) spawn(range{ offset, counts[b], r.depth, r.byte + 1 });
+                offset += counts[b];
+            }
+            return;
+        }
+    }
+
+    void sort(range r) const {
+        step(r, [this](range child) { sort(child); });
+    }
+
+private:
+    static void small_sort(entry* first, size_t size, size_t depth) {
+        auto less = [depth](const entry& lhv, const entry& rhv) {
+            if(lhv.key != rhv.key) return lhv.key < rhv.key;
+            return lhv.view.substr(depth) < rhv.view.substr(depth);
+        };
+        if(Stable) std::stable_sort(first, first + size, less);
+        else std::sort(first, first + size, less);
+    }
+
+    // moves the views that end within the current key to the front, ordered by size; returns how many there are
+    size_t split_ended(range r) const {
+        auto first = data_ + r.first;
+        auto scratch = scratch_ + r.first;
+        auto limit = r.depth + 8;
+        size_t ended = 0;
+        for(size_t ix = 0; ix < r.size; ++ix)
+            if(first[ix].view.size() <= limit) scratch[ended++] = first[ix];
+        if(ended == 0) return 0;
+        auto rest = ended;
+        for(size_t ix = 0; ix < r.size; ++ix)
+            if(first[ix].view.size() > limit) scratch[rest++] = first[ix];
+        std::stable_sort(scratch, scratch + ended,
+            [](const entry& lhv, const entry& rhv) { return lhv.view.size() < rhv.view.size(); });
+        std::copy(scratch, scratch + r.size, first);
+        return ended;
+    }
+};
+
+// runs `f(ix)` for ix in [0, parts) on up to `threads` threads, the calling one included
+template<class F>
+void parallel_parts(size_t parts, unsigned threads, F&& f) {
+    std::vector<std::thread> workers;
+    for(size_t ix = 1; ix < parts && ix < threads; ++ix) workers.emplace_back([&f, ix] { f(ix); });
+    if(parts > 0) f(0);
+    for(auto&& w : workers) w.join();
+}
+
+template<bool Stable, class It>
+void radix_sort_views(It first, It last, unsigned threads) {
+    using view_type = typename std::iterator_traits<It>::value_type;
+    using entry = sort_entry<view_type>;
+    using sorter = msd_radix_sorter<view_type, Stable>;
+    using range = typename sorter::range;
+
+    // below this size a bucket is not worth a hand-off to another thread
+    const size_t task_limit = 1 << 15;
+
+    auto size = size_t(std::distance(first, last));
+    if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    if(size < 2 * task_limit) threads = 1;
+
+    std::vector<entry> entries(size);
+    std::vector<entry> scratch(size);
+    auto chunk = (size + threads - 1) / threads;
+    parallel_parts(threads, threads, [&](size_t part) {
+        auto from = std::min(size, part * chunk), to = std::min(size, from + chunk);
+        auto it = std::next(first, ptrdiff_t(from));
+        for(auto ix = from; ix < to; ++ix, ++it) entries[ix] = entry{ prefix_key(*it, 0), *it };
+    });
+
+    sorter s(entries.data(), scratch.data());
+    if(threads == 1) s.sort(range{ 0, size, 0, 0 });
+    else {
+        // buckets split off large ones go to a shared stack for whichever thread is idle
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::vector<range> pending{ range{ 0, size, 0, 0 } };
+        size_t busy = 0;
+        parallel_parts(threads, threads, [&](size_t) {
+            std::unique_lock<std::mutex> lock(mutex);
+            while(true) {
+                ready.wait(lock, [&] { return !pending.empty() || busy == 0; });
+                if(pending.empty()) return;
+                auto r = pending.back();
+                pending.pop_back();
+                ++busy;
+                lock.unlock();
+                s.step(r, [&](range child) {
+                    if(child.size < task_limit) {
+                        s.sort(child);
+                        return;
+                    }
+                    std::lock_guard<std::mutex> guard(mutex);
+                    pending.push_back(child);
+                    ready.notify_one();
+                });
+                lock.lock();
+                if(--busy == 0 && pending.empty()) ready.notify_all();
+            }
+        });
+    }
+
+    parallel_parts(threads, threads, [&](size_t part) {
+        auto from = std::min(size, part * chunk), to = std::min(size, from + chunk);
+        auto it = std::next(first, ptrdiff_t(from));
+        for(auto ix = from; ix < to; ++ix, ++it) *it = entries[ix].view;
+    });
+}
+
+template<class View>
+struct radix_sortable: std::false_type {};
+// byte order is operator< order only for plain narrow characters
+template<class Char, class Traits>
+struct radix_sortable<basic_string_view<Char, Traits>>:
+    std::integral_constant<bool, sizeof(Char) == 1 && is_plain_traits<Char, Traits>::value> {};
+
+template<bool Stable, class It>
+void sort_views(It first, It last, unsigned threads, std::true_type) {
+    radix_sort_views<Stable>(first, last, threads);
+}
+
+template<bool Stable, class It>
+void sort_views(It first, It last, unsigned, std::false_type) {
+    if(Stable) std::stable_sort(first, last);
+    else std::sort(first, last);
+}
+
+} /* namespace detail */
+
+/*
+ * Sorts a random access range of views into operator< order.
+ * Narrow views with plain traits go through a parallel MSD radix sort on cached 8-byte prefixes,
+ * everything else through std::sort.
+ * `threads == 0` means one per hardware thread; small inputs always run on the calling thread.
+ */
+template<class It>
+void sort_views(It first, It last, unsigned threads = 0) {
+    using view_type = typename std::iterator_traits<It>::value_type;
+    detail::sort_views<false>(first, last, threads, detail::radix_sortable<view_type>{});
+}
+
+// as sort_views, equal views keep their relative order
+template<class It>
+void stable_sort_views(It first, It last, unsigned threads = 0) {
+    using view_type = typename std::iterator_traits<It>::value_type;
+    detail::sort_views<true>(first, last, threads, detail::radix_sortable<view_type>{});
+}
+
+// sorts and drops repeated views, keeping the first occurrence of each; returns the new end
+template<class It>
+It unique_views(It first, It last, unsigned threads = 0) {
+    stable_sort_views(first, last, threads);
+    return std::unique(first, last);
+}
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_SORT_VIEWS_HPP */
@@ -0,0 +1,262 @@
+#ifndef ESSENTIALS_SPLIT_HPP
+#define ESSENTIALS_SPLIT_HPP
+
+#include <iterator>
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+enum class split_mode { keep_empty, skip_empty };
+
+namespace detail {
+
+/*
+ * Delimiters: `next(first, last)` gives the start of the next delimiter in [first, last)
+ * or nullptr, `length()` its length.
+ * Every one of them runs on the vectorized kernels of basic_string_view.
+ */
+template<class Char, class Traits>
+class char_delimiter {
+    Char delim_;
+
+public:
+    explicit char_delimiter(Char delim) noexcept: delim_(delim) {}
+    const Char* next(const Char* first, const Char* last) const noexcept {
+        return Traits::find(first, size_t(last - first), delim_);
+    }
+    size_t length() const noexcept { return 1; }
+};
+
+// an empty delimiter never matches
+template<class Char, class Traits>
+class string_delimiter {
+    basic_string_view<Char, Traits> delim_;
+
+public:
+    explicit string_delimiter(basic_string_view<Char, Traits> delim) noexcept: delim_(delim) {}
+    const Char* next(const Char* first, const Char* last) const noexcept {
+        auto size = size_t(last - first);
+        if(delim_.empty() || delim_.size() > size) return nullptr;
+        return kernels<Char, Traits>::find(first, size, delim_.data(), delim_.size());
+    }
+    size_t length() const noexcept { return delim_.size(); }
+};
+
+template<class Char, class Traits>
+class set_delimiter {
+    basic_char_set<Char, Traits> set_;
+
+public:
+    explicit set_delimiter(basic_char_set<Char, Traits> set) noexcept: set_(std::move(set)) {}
+    const Char* next(const Char* first, const Char* last) const noexcept {
+        return set_.find_first(first, last, true);
+    }
+    size_t length() const noexcept { return 1; }
+};
+
+} /* namespace detail */
+
+/*
+ * Lazy forward range over the fields of a view.
+ * Fields are views into the original data, nothing is allocated.
+ * At most `max_splits` delimiters are consumed, the rest of the view becomes the last field;
+ * with split_mode::skip_empty empty fields are dropped and do not count as splits.
+ */
+template<class Char, class Traits, class Delimiter>
+class basic_split_range {
+public:
+    using view_type = basic_string_view<Char, Traits>;
+
+private:
+    view_type view_;
+    Delimiter delim_;
+    split_mode mode_;
+    size_t max_splits_;
+
+public:
+    class iterator {
+        const basic_split_range* range_ = nullptr;
+        view_type field_;
+        const Char* rest_ = nullptr;
+        size_t splits_left_ = 0;
+        bool last_ = false;
+
+        friend class basic_split_range;
+
+        iterator(const basic_split_range* range) noexcept:
+            range_(range), rest_(range->view_.data()), splits_left_(range->max_splits_) {
+            advance();
+        }
+
+        void advance() noexcept {
+            auto&& v = range_->view_;
+            auto end = v.data() + v.size();
+            do {
+                if(last_) {
+                    range_ = nullptr;
+                    return;
+                }
+                auto found = (splits_left_ == 0)? nullptr : range_->delim_.next(rest_, end);
+                if(found == nullptr) {
+                    field_ = view_type(rest_, size_t(end - rest_));
+                    last_ = true;
+                } else {
+                    field_ = view_type(rest_, size_t(found - rest_));
+                    rest_ = found + range_->delim_.length();
+                    if(!(range_->mode_ == split_mode::skip_empty && field_.empty())) --splits_left_;
+                }
+            } while(range_->mode_ == split_mode::skip_empty && field_.empty());
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = view_type;
+        using difference_type = ptrdiff_t;
+        using pointer = const view_type*;
+        using reference = const view_type&;
+
+        iterator() noexcept = default;
+
+        reference operator*() const noexcept { return field_; }
+        pointer operator->() const noexcept { return &field_; }
+
+        iterator& operator++() noexcept {
+            advance();
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            auto tmp = *this;
+            advance();
+            return tmp;
+        }
+
+        friend bool operator==(const iterator& lhv, const iterator& rhv) noexcept {
+            if(lhv.range_ == nullptr || rhv.range_ == nullptr) return lhv.range_ == rhv.range_;
+            return lhv.field_.data() == rhv.field_.data() && lhv.last_ == rhv.last_;
+        }
+        friend bool operator!=(const iterator& lhv, const iterator& rhv) noexcept {
+            return not (lhv == rhv);
+        }
+    };
+    using const_iterator = iterator;
+
+    basic_split_range(view_type view, Delimiter delim, split_mode mode, size_t max_splits) noexcept:
+        view_(view), delim_(std::move(delim)), mode_(mode), max_splits_(max_splits) {}
+
+    iterator begin() const noexcept { return iterator(this); }
+    iterator end() const noexcept { return iterator(); }
+};
+
+template<class Char, class Traits>
+basic_split_range<Char, Traits, detail::char_delimiter<Char, Traits>>
+split(basic_string_view<Char, Traits> v, typename detail::identity<Char>::type delim,
+      split_mode mode = split_mode::keep_empty, size_t max_splits = basic_string_view<Char, Traits>::npos) noexcept {
+    return { v, detail::char_delimiter<Char, Traits>(delim), mode, max_splits };
+}
+
+template<class Char, class Traits>
+basic_split_range<Char, Traits, detail::string_delimiter<Char, Traits>>
+split(basic_string_view<Char, Traits> v, typename detail::identity<basic_string_view<Char, Traits>>::type delim,
+      split_mode mode = split_mode::keep_empty, size_t max_splits = basic_string_view<Char, Traits>::npos) noexcept {
+    return { v, detail::string_delimiter<Char, Traits>(delim), mode, max_splits };
+}
+
+template<class Char, class Traits>
+basic_split_range<Char, Traits, detail::string_delimiter<Char, Traits>>
+split(basic_string_view<Char, Traits> v, const Char* delim,
+      split_mode mode = split_mode::keep_empty, size_t max_splits = basic_string_view<Char, Traits>::npos) noexcept {
+    return { v, detail::string_delimiter<Char, Traits>(delim), mode, max_splits };
+}
+
+template<class Char, class Traits>
+basic_split_range<Char, Traits, detail::set_delimiter<Char, Traits>>
+split(basic_string_view<Char, Traits> v, basic_char_set<Char, Traits> delims,
+      split_mode mode = split_mode::keep_empty, size_t max_splits = basic_string_view<Char, Traits>::npos) {
+    return { v, detail::set_delimiter<Char, Traits>(std::move(delims)), mode, max_splits };
+}
+
+/*
+ * Lazy forward range over the lines of a view.
+ * Lines end at '\n', a '\r' right before it is dropped as well;
+ * a trailing newline does not start one more (empty) line.
+ */
+template<class Char, class Traits>
+class basic_line_range {
+public:
+    using view_type = basic_string_view<Char, Traits>;
+
+private:
+    view_type view_;
+
+public:
+    class iterator {
+        view_type line_;
+        const Char* rest_ = nullptr;
+        const Char* end_ = nullptr;
+
+        friend class basic_line_range;
+
+        iterator(view_type v) noexcept: rest_(v.data()), end_(v.data() + v.size()) {
+            advance();
+        }
+
+        void advance() noexcept {
+            if(rest_ == end_) {
+                rest_ = end_ = nullptr;
+                return;
+            }
+            auto found = Traits::find(rest_, size_t(end_ - rest_), Char('\n'));
+            auto stop = (found == nullptr)? end_ : found;
+            auto size = size_t(stop - rest_);
+            if(found != nullptr && size > 0 && Traits::eq(rest_[size - 1], Char('\r'))) --size;
+            line_ = view_type(rest_, size);
+            rest_ = (found == nullptr)? end_ : found + 1;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = view_type;
+        using difference_type = ptrdiff_t;
+        using pointer = const view_type*;
+        using reference = const view_type&;
+
+        iterator() noexcept = default;
+
+        reference operator*() const noexcept { return line_; }
+        pointer operator->() const noexcept { return &line_; }
+
+        iterator& operator++() noexcept {
+            advance();
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            auto tmp = *this;
+            advance();
+            return tmp;
+        }
+
+        friend bool operator==(const iterator& lhv, const iterator& rhv) noexcept {
+            if(lhv.end_ == nullptr || rhv.end_ == nullptr) return lhv.end_ == rhv.end_;
+            return lhv.line_.data() == rhv.line_.data();
+        }
+        friend bool operator!=(const iterator& lhv, const iterator& rhv) noexcept {
+            return not (lhv == rhv);
+        }
+    };
+    using const_iterator = iterator;
+
+    explicit basic_line_range(view_type view) noexcept: view_(view) {}
+
+    iterator begin() const noexcept { return iterator(view_); }
+    iterator end() const noexcept { return iterator(); }
+};
+
+template<class Char, class Traits>
+basic_line_range<Char, Traits> lines(basic_string_view<Char, Traits> v) noexcept {
+    return basic_line_range<Char, Traits>(v);
+}
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_SPLIT_HPP */
@@ -0,0 +1,176 @@
+#ifndef ESSENTIALS_STATIC_STRING_MAP_HPP
+#define ESSENTIALS_STATIC_STRING_MAP_HPP
+
+#include <stdexcept>
+#include <utility>
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+namespace detail {
+
+// Traits::eq is constexpr in C++14 where Traits::compare (and so operator==) is not
+template<class Char, class Traits>
+constexpr bool constexpr_equal(basic_string_view<Char, Traits> lhv, basic_string_view<Char, Traits> rhv) noexcept {
+    if(lhv.size() != rhv.size()) return false;
+    for(size_t ix = 0; ix < lhv.size(); ++ix)
+        if(!Traits::eq(lhv[ix], rhv[ix])) return false;
+    return true;
+}
+
+// the constexpr loop while constant evaluating, operator== (memcmp) at run time
+template<class Char, class Traits>
+constexpr bool keys_equal(basic_string_view<Char, Traits> lhv, basic_string_view<Char, Traits> rhv) noexcept {
+#if defined(__has_builtin)
+#   if __has_builtin(__builtin_is_constant_evaluated)
+    if(!__builtin_is_constant_evaluated()) return lhv == rhv;
+#   endif
+#endif
+    return constexpr_equal(lhv, rhv);
+}
+
+constexpr size_t next_power_of_two(size_t n) noexcept {
+    size_t res = 1;
+    while(res < n) res *= 2;
+    return res;
+}
+
+// the smallest unsigned type holding [0, N]
+template<size_t N>
+using slot_index_t = typename std::conditional<(N < 0x100), uint8_t,
+    typename std::conditional<(N < 0x10000), uint16_t, uint32_t>::type>::type;
+
+} /* namespace detail */
+
+/*
+ * A fixed map from string keys to values with a perfect hash found at compile time (hash and displace):
+ * keys hash once into one of N buckets, each bucket has a displacement that sends its keys
+ * to free slots of a table twice the size. A lookup is one hash, one multiply and one key comparison.
+ * Built from a constexpr make_static_string_map, the whole table lives in read-only data;
+ * duplicate keys fail the build. index() of a constant key is a constant, so it works as a case label.
+ * Policy has to agree with Traits' equality (the default, like the rest of the hashing, hashes raw code units).
+ */
+template<class Value, size_t N, class Char = char, class Traits = std::char_traits<Char>, class Policy = wyhash_policy>
+class static_string_map {
+    static_assert(N > 0, "static_string_map needs at least one key");
+
+public:
+    using view_type = basic_string_view<Char, Traits>;
+    using value_type = Value;
+    using item_type = std::pair<view_type, Value>;
+
+private:
+    static constexpr size_t bucket_count = detail::next_power_of_two(N);
+    static constexpr size_t table_size = 2 * bucket_count;
+    using slot_type = detail::slot_index_t<N>;
+
+    view_type keys_[N];
+    Value values_[N];
+    uint64_t seed_ = 0;
+    uint64_t displacements_[bucket_count] = {};
+    // key indices, N for an empty slot
+    slot_type slots_[table_size] = {};
+
+    constexpr uint64_t hash(view_type key) const noexcept { return Policy::hash(key.data(), key.size(), seed_); }
+    static constexpr size_t slot_of(uint64_t hash, uint64_t displacement) noexcept {
+        return size_t(detail::mix(hash, displacement)) & (table_size - 1);
+    }
+
+    // places every key for the current seed, or gives up for the caller to try another one
+    constexpr bool place() noexcept {
+        uint64_t hashes[N] = {};
+        size_t sizes[bucket_count] = {}, order[bucket_count] = {};
+        for(size_t ix = 0; ix < N; ++ix) {
+            hashes[ix] = hash(keys_[ix]);
+            ++sizes[hashes[ix] & (bucket_count - 1)];
+        }
+        for(auto&& s : slots_) s = slot_type(N);
+
+        // largest buckets first, while the table is emptiest
+        for(size_t ix = 0; ix < bucket_count; ++ix) {
+            auto jx = ix;
+            for(; jx > 0 && sizes[order[jx - 1]] < sizes[ix]; --jx) order[jx] = order[jx - 1];
+            order[jx] = ix;
+        }
+
+        size_t members[N] = {}, taken[N] = {};
+        for(size_t ox = 0; ox < bucket_count && sizes[order[ox]] != 0; ++ox) {
+            auto bucket = order[ox];
+            size_t count = 0;
+            for(size_t ix = 0; ix < N; ++ix)
+                if((hashes[ix] & (bucket_count - 1)) == bucket) members[count++] = ix;
+
+            bool placed = false;
+            for(uint64_t attempt = 1; !placed && attempt <= 64 * table_size; ++attempt) {
+                auto displacement = attempt * 0x9E3779B97F4A7C15ULL;
+                placed = true;
+                for(size_t mx = 0; placed && mx < count; ++mx) {
+                    taken[mx] = slot_of(hashes[members[mx]], displacement);
+                    placed = slots_[taken[mx]] == slot_type(N);
+                    for(size_t kx = 0; placed && kx < mx; ++kx) placed = taken[kx] != taken[mx];
+                }
+                if(placed) {
+                    displacements_[bucket] = displacement;
+                    for(size_t mx = 0; mx < count; ++mx) slots_[taken[mx]] = slot_type(members[mx]);
+                }
+            }
+            if(!placed) return false;
+        }
+        return true;
+    }
+
+    template<size_t... Ix>
+    constexpr static_string_map(const item_type (&items)[N], std::index_sequence<Ix...>):
+        keys_{ items[Ix].first... }, values_{ items[Ix].second... } {
+        for(size_t ix = 0; ix < N; ++ix)
+            for(size_t jx = 0; jx < ix; ++jx)
+                if(detail::constexpr_equal(keys_[ix], keys_[jx])) throw std::invalid_argument("static_string_map: duplicate key");
+        for(uint64_t attempt = 0; attempt < 64; ++attempt) {
+            seed_ = detail::mix(attempt ^ 0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL);
+            if(place()) return;
+        }
+        throw std::logic_error("static_string_map: no perfect hash found");
+    }
+
+public:
+    constexpr explicit static_string_map(const item_type (&items)[N]):
+        static_string_map(items, std::make_index_sequence<N>()) {}
+
+    // the index of `key` in the list the map was built from, size() if it is not there
+    constexpr size_t index(view_type key) const noexcept {
+        auto h = hash(key);
+        size_t ix = slots_[slot_of(h, displacements_[h & (bucket_count - 1)])];
+        return (ix != N && detail::keys_equal(keys_[ix], key))? ix : N;
+    }
+
+    constexpr const Value* find(view_type key) const noexcept {
+        auto ix = index(key);
+        return (ix != N)? &values_[ix] : nullptr;
+    }
+    constexpr bool contains(view_type key) const noexcept { return index(key) != N; }
+    constexpr const Value& at(view_type key) const {
+        auto ix = index(key);
+        if(ix == N) throw std::out_of_range("static_string_map: no such key");
+        return values_[ix];
+    }
+    // `fallback` for a missing key
+    constexpr Value get(view_type key, Value fallback) const {
+        auto ix = index(key);
+        return (ix != N)? values_[ix] : fallback;
+    }
+
+    static constexpr size_t size() noexcept { return N; }
+    constexpr view_type key(size_t ix) const noexcept { return keys_[ix]; }
+    constexpr const Value& value(size_t ix) const noexcept { return values_[ix]; }
+};
+
+// make_static_string_map<int>({ { "get"_sv, 1 }, { "set"_sv, 2 } }), constexpr if Value is a literal type
+template<class Value, size_t N>
+constexpr static_string_map<Value, N> make_static_string_map(const std::pair<string_view, Value> (&items)[N]) {
+    return static_string_map<Value, N>(items);
+}
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_STATIC_STRING_MAP_HPP */
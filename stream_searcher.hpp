@@ -0,0 +1,111 @@
+#ifndef ESSENTIALS_STREAM_SEARCHER_HPP
+#define ESSENTIALS_STREAM_SEARCHER_HPP
+
+#include <vector>
+
+#include "searcher.hpp"
+
+namespace essentials {
+
+/*
+ * Finds a needle in data that arrives as a sequence of chunks, matches spanning chunks included,
+ * without copying the chunks anywhere.
+ * Inside a chunk the search is basic_searcher's; what carries over between chunks is the KMP state,
+ * the length of the needle prefix the data seen so far ends with. A new chunk is stepped through KMP
+ * only while that pending partial match can still complete, i.e. for less than the needle size.
+ * Every occurrence is reported, overlapping ones included, as an offset from the start of the stream.
+ * An empty needle never matches. The needle is not copied and has to outlive the searcher.
+ */
+template<class Char, class Traits = std::char_traits<Char>>
+class basic_stream_searcher {
+public:
+    using view_type = basic_string_view<Char, Traits>;
+
+private:
+    basic_searcher<Char, Traits> searcher_;
+    // fail_[q]: the longest proper border of the needle's first q code units
+    std::vector<size_t> fail_;
+    size_t state_ = 0;
+    size_t offset_ = 0;
+
+    size_t step(size_t q, Char c) const noexcept {
+        auto needle = searcher_.needle().data();
+        while(q != 0 && !Traits::eq(needle[q], c)) q = fail_[q];
+        if(Traits::eq(needle[q], c)) ++q;
+        return q;
+    }
+
+public:
+    explicit basic_stream_searcher(view_type needle): searcher_(needle), fail_(needle.size() + 1, 0) {
+        for(size_t q = 1; q < needle.size(); ++q) {
+            auto k = fail_[q];
+            while(k != 0 && !Traits::eq(needle[k], needle[q])) k = fail_[k];
+            if(Traits::eq(needle[k], needle[q])) ++k;
+            fail_[q + 1] = k;
+        }
+    }
+
+    view_type needle() const noexcept { return searcher_.needle(); }
+    // code units fed so far
+    size_t offset() const noexcept { return offset_; }
+    // code units at the end of the stream that may still turn out to begin a match
+    size_t pending() const noexcept { return state_; }
+    // starts over as if nothing was fed
+    void reset() noexcept { state_ = offset_ = 0; }
+
+    // searches the next chunk, calling `on_match(offset)` for every match ending in it, in order
+    template<class F>
+    void feed(view_type chunk, F&& on_match) {
+        auto m = needle().size();
+        auto n = chunk.size();
+        if(m == 0) return;
+        if(n < m) {
+            // too short to hold a match of its own: all of it goes through the automaton
+            for(size_t ix = 0; ix < n; ++ix) {
+                state_ = step(state_, chunk[ix]);
+                if(state_ == m) {
+                    on_match(offset_ + ix + 1 - m);
+                    state_ = fail_[m];
+                }
+            }
+            offset_ += n;
+            return;
+        }
+
+        // matches begun in earlier chunks, as long as the partial one started before this chunk did
+        for(size_t ix = 0; state_ > ix; ++ix) {
+            state_ = step(state_, chunk[ix]);
+            if(state_ == m) {
+                on_match(offset_ + ix + 1 - m);
+                state_ = fail_[m];
+            }
+        }
+        for(auto pos = searcher_(chunk); pos != view_type::npos; pos = searcher_(chunk, pos + 1)) on_match(offset_ + pos);
+
+        // the state after the chunk only depends on its last m - 1 code units, from where the needle's first one occurs
+        state_ = 0;
+        auto tail = Traits::find(chunk.data() + n - (m - 1), m - 1, needle()[0]);
+        if(tail != nullptr)
+            for(auto ix = size_t(tail - chunk.data()); ix < n; ++ix) state_ = step(state_, chunk[ix]);
+        offset_ += n;
+    }
+
+    // the offsets of the matches ending in `chunk`
+    std::vector<size_t> feed(view_type chunk) {
+        std::vector<size_t> res;
+        feed(chunk, [&res](size_t offset) { res.push_back(offset); });
+        return res;
+    }
+};
+
+template<class Char, class Traits>
+basic_stream_searcher<Char, Traits> make_stream_searcher(basic_string_view<Char, Traits> needle) {
+    return basic_stream_searcher<Char, Traits>(needle);
+}
+
+using stream_searcher = basic_stream_searcher<char>;
+using wstream_searcher = basic_stream_searcher<wchar_t>;
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_STREAM_SEARCHER_HPP */
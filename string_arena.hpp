@@ -0,0 +1,148 @@
+#ifndef ESSENTIALS_STRING_ARENA_HPP
+#define ESSENTIALS_STRING_ARENA_HPP
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+struct arena_stats {
+    // strings handed out over the arena's lifetime
+    size_t allocations = 0;
+    // code units handed out and not yet released by reset or rewind
+    size_t used = 0;
+    // the most `used` ever got
+    size_t peak = 0;
+    // code units held in chunks and large blocks
+    size_t reserved = 0;
+    size_t chunks = 0;
+    size_t large_blocks = 0;
+};
+
+/*
+ * Bump allocator turning borrowed views into owned, stable ones.
+ * Strings are copied into fixed-size chunks; ones larger than a quarter of a chunk get a block of their own.
+ * Views stay valid until the arena is reset, released or rewound past them.
+ * reset and rewind keep the chunks for reuse, so a per-request arena stops allocating once warmed up.
+ */
+template<class Char, class Traits = std::char_traits<Char>>
+class basic_string_arena {
+public:
+    using view_type = basic_string_view<Char, Traits>;
+
+    // a position to rewind to; marks taken after it are invalidated by the rewind
+    struct mark {
+        size_t chunk;
+        size_t used;
+        size_t large;
+        size_t total;
+    };
+
+    // rewinds the arena to where it was on construction
+    class scope {
+        basic_string_arena& arena_;
+        mark mark_;
+
+    public:
+        explicit scope(basic_string_arena& arena) noexcept: arena_(arena), mark_(arena.position()) {}
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+        ~scope() { arena_.rewind(mark_); }
+    };
+
+private:
+    std::vector<std::unique_ptr<Char[]>> chunks_;
+    std::vector<std::pair<std::unique_ptr<Char[]>, size_t>> large_;
+    // chunks_[current_ - 1] is the one being filled, none while current_ is 0
+    size_t current_ = 0;
+    size_t used_ = 0;
+    size_t chunk_size_;
+    size_t allocations_ = 0;
+    size_t total_ = 0;
+    size_t peak_ = 0;
+
+public:
+    explicit basic_string_arena(size_t chunk_size = 64 * 1024) noexcept: chunk_size_(chunk_size? chunk_size : 1) {}
+
+    basic_string_arena(const basic_string_arena&) = delete;
+    basic_string_arena& operator=(const basic_string_arena&) = delete;
+    basic_string_arena(basic_string_arena&&) = default;
+    basic_string_arena& operator=(basic_string_arena&&) = default;
+
+    // room for `size` code units
+    Char* allocate(size_t size) {
+        ++allocations_;
+        total_ += size;
+        peak_ = std::max(peak_, total_);
+        if(size > chunk_size_ / 4) {
+            // keep the current chunk for the small strings that follow
+            large_.emplace_back(std::unique_ptr<Char[]>(new Char[size]), size);
+            return large_.back().first.get();
+        }
+        if(current_ == 0 || chunk_size_ - used_ < size) {
+            if(current_ == chunks_.size()) chunks_.emplace_back(new Char[chunk_size_]);
+            ++current_;
+            used_ = 0;
+        }
+        auto res = chunks_[current_ - 1].get() + used_;
+        used_ += size;
+        return res;
+    }
+
+    // a copy of `v` owned by the arena
+    view_type store(view_type v) {
+        if(v.empty()) return view_type();
+        auto data = allocate(v.size());
+        Traits::copy(data, v.data(), v.size());
+        return view_type(data, v.size());
+    }
+
+    mark position() const noexcept { return mark{ current_, used_, large_.size(), total_ }; }
+
+    // drops everything stored after `m`
+    void rewind(mark m) noexcept {
+        current_ = m.chunk;
+        used_ = m.used;
+        large_.resize(m.large);
+        total_ = m.total;
+    }
+
+    // drops everything, keeping the chunks
+    void reset() noexcept { rewind(mark{ 0, 0, 0, 0 }); }
+
+    // drops everything and frees the memory
+    void release() noexcept {
+        reset();
+        chunks_.clear();
+    }
+
+    arena_stats stats() const noexcept {
+        arena_stats res;
+        res.allocations = allocations_;
+        res.used = total_;
+        res.peak = peak_;
+        res.chunks = chunks_.size();
+        res.large_blocks = large_.size();
+        res.reserved = chunks_.size() * chunk_size_;
+        for(auto&& block : large_) res.reserved += block.second;
+        return res;
+    }
+
+    size_t chunk_size() const noexcept { return chunk_size_; }
+
+    // one arena per thread, for code without a natural owner to pass around
+    static basic_string_arena& local() {
+        static thread_local basic_string_arena arena;
+        return arena;
+    }
+};
+
+using string_arena = basic_string_arena<char>;
+using wstring_arena = basic_string_arena<wchar_t>;
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_STRING_ARENA_HPP */
@@ -1,10 +1,631 @@
+#ifndef ESSENTIALS_STRING_VIEW_HPP
+#define ESSENTIALS_STRING_VIEW_HPP
+
 #include <iostream>
 #include <string>
 #include <limits>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <random>
+#include <utility>
+
+// the SSE2 kernels carry no target attribute: 32-bit builds get them only when SSE2 is on for the whole build
+#if !defined(ESSENTIALS_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#   define ESSENTIALS_SIMD_X86 1
+#   include <immintrin.h>
+#endif
+
+// see instrument.hpp; hooks are skipped while constant evaluating, where thread-locals are out of reach.
+// The macro stays defined past this header: kernels specialized elsewhere (ci_string_view.hpp) report through it too
+#ifdef ESSENTIALS_INSTRUMENT
+#   include "instrument.hpp"
+#   define ESSENTIALS_HOOK(CALL) do { if(!__builtin_is_constant_evaluated()) ::essentials::detail::CALL; } while(false)
+#else
+#   define ESSENTIALS_HOOK(CALL) ((void) 0)
+#endif
 
 namespace essentials {
 
+namespace detail {
+
+#ifdef ESSENTIALS_SIMD_X86
+struct cpu {
+    static bool has_avx2() noexcept {
+        static const bool value = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+        return value;
+    }
+    static bool has_ssse3() noexcept {
+        static const bool value = (__builtin_cpu_init(), __builtin_cpu_supports("ssse3"));
+        return value;
+    }
+    static bool has_pclmul() noexcept {
+        static const bool value = (__builtin_cpu_init(), __builtin_cpu_supports("pclmul"));
+        return value;
+    }
+};
+#endif
+
+template<class Char, class Traits>
+struct is_plain_traits: std::is_same<Traits, std::char_traits<Char>> {};
+
+// narrow traits whose basic_char_set is as cheap to build as the plain one
+template<class Char, class Traits>
+struct fast_char_set: is_plain_traits<Char, Traits> {};
+
+// keeps a parameter out of template argument deduction
+template<class T>
+struct identity { using type = T; };
+
+/*
+ * Crochemore-Perrin Two-Way search.
+ * Linear time, constant space; used for needles too long for the SIMD filter.
+ * The Reverse flavour runs the same algorithm over the mirrored needle and haystack,
+ * finding the last occurrence.
+ */
+template<class Char, class Traits, bool Reverse = false>
+class two_way {
+    const Char* needle_ = nullptr;
+    ptrdiff_t size_ = 0;
+    ptrdiff_t ell_ = -1;
+    ptrdiff_t period_ = 1;
+    bool periodic_ = false;
+
+    static Char at(const Char* s, ptrdiff_t size, ptrdiff_t ix) noexcept {
+        return Reverse? s[size - 1 - ix] : s[ix];
+    }
+    Char x(ptrdiff_t ix) const noexcept { return at(needle_, size_, ix); }
+
+    ptrdiff_t max_suffix(bool tilde, ptrdiff_t& p) const noexcept {
+        ptrdiff_t ms = -1, j = 0, k = 1;
+        p = 1;
+        while(j + k < size_) {
+            auto a = x(j + k);
+            auto b = x(ms + k);
+            if(Traits::eq(a, b)) {
+                if(k != p) ++k;
+                else { j += p; k = 1; }
+            } else if(tilde? Traits::lt(b, a) : Traits::lt(a, b)) {
+                j += k; k = 1; p = j - ms;
+            } else {
+                ms = j; j = ms + 1; k = p = 1;
+            }
+        }
+        return ms;
+    }
+
+public:
+    two_way() noexcept = default;
+    two_way(const Char* needle, size_t size) noexcept: needle_(needle), size_(ptrdiff_t(size)) {
+        if(size_ == 0) return;
+        ptrdiff_t p, q;
+        auto i = max_suffix(false, p);
+        auto j = max_suffix(true, q);
+        if(i > j) { ell_ = i; period_ = p; }
+        else { ell_ = j; period_ = q; }
+        periodic_ = period_ + ell_ + 1 <= size_;
+        for(ptrdiff_t ix = 0; periodic_ && ix <= ell_; ++ix)
+            periodic_ = Traits::eq(x(ix), x(ix + period_));
+        if(!periodic_) period_ = (ell_ + 1 > size_ - ell_ - 1? ell_ + 1 : size_ - ell_ - 1) + 1;
+    }
+
+    // first (last for Reverse) occurrence in [hay, hay + size)
+    const Char* find(const Char* hay, size_t size) const noexcept {
+        auto n = ptrdiff_t(size);
+        auto m = size_;
+        auto y = [hay, n](ptrdiff_t ix) { return at(hay, n, ix); };
+        auto result = [hay, n, m](ptrdiff_t j) { return Reverse? hay + (n - j - m) : hay + j; };
+        if(m == 0) return result(0);
+        ptrdiff_t j = 0;
+        if(periodic_) {
+            ptrdiff_t memory = -1;
+            while(j <= n - m) {
+                auto i = (ell_ > memory? ell_ : memory) + 1;
+                while(i < m && Traits::eq(x(i), y(i + j))) ++i;
+                if(i >= m) {
+                    i = ell_;
+                    while(i > memory && Traits::eq(x(i), y(i + j))) --i;
+                    if(i <= memory) return result(j);
+                    j += period_;
+                    memory = m - period_ - 1;
+                } else {
+                    j += i - ell_;
+                    memory = -1;
+                }
+            }
+        } else {
+            while(j <= n - m) {
+                auto i = ell_ + 1;
+                while(i < m && Traits::eq(x(i), y(i + j))) ++i;
+                if(i >= m) {
+                    i = ell_;
+                    while(i >= 0 && Traits::eq(x(i), y(i + j))) --i;
+                    if(i < 0) return result(j);
+                    j += period_;
+                } else {
+                    j += i - ell_;
+                }
+            }
+        }
+        return nullptr;
+    }
+};
+
+/*
+ * Search kernels over raw ranges.
+ * Every kernel works on [data, data + size) and returns a pointer to the result or nullptr,
+ * bounds are the caller's responsibility.
+ */
+template<class Char, class Traits>
+struct scalar_kernels {
+    // needles longer than this are handed over to Two-Way
+    static constexpr size_t two_way_threshold = 64;
+
+    static const Char* find(const Char* hay, size_t n, const Char* needle, size_t m) noexcept {
+        if(m == 1) {
+            ESSENTIALS_HOOK(count_kernel(view_op::find, view_kernel::library));
+            return Traits::find(hay, n, *needle);
+        }
+        if(m > two_way_threshold) {
+            ESSENTIALS_HOOK(count_kernel(view_op::find, view_kernel::two_way));
+            return two_way<Char, Traits>(needle, m).find(hay, n);
+        }
+        ESSENTIALS_HOOK(count_kernel(view_op::find, view_kernel::scalar));
+        auto last = hay + (n - m) + 1;
+        for(auto it = hay; it < last; ++it) {
+            it = Traits::find(it, size_t(last - it), *needle);
+            if(it == nullptr) return nullptr;
+            if(Traits::eq(it[m - 1], needle[m - 1]) && Traits::compare(it + 1, needle + 1, m - 2) == 0)
+                return it;
+            ESSENTIALS_HOOK(count_mismatch(view_op::find));
+        }
+        return nullptr;
+    }
+
+    static const Char* rfind_scan(const Char* hay, size_t n, Char needle) noexcept {
+        while(n != 0)
+            if(Traits::eq(hay[--n], needle)) return hay + n;
+        return nullptr;
+    }
+
+    static const Char* rfind(const Char* hay, size_t n, Char needle) noexcept {
+        ESSENTIALS_HOOK(count_kernel(view_op::rfind, view_kernel::scalar));
+        return rfind_scan(hay, n, needle);
+    }
+
+    static const Char* rfind(const Char* hay, size_t n, const Char* needle, size_t m) noexcept {
+        if(m == 1) return rfind(hay, n, *needle);
+        if(m > two_way_threshold) {
+            ESSENTIALS_HOOK(count_kernel(view_op::rfind, view_kernel::two_way));
+            return two_way<Char, Traits, true>(needle, m).find(hay, n);
+        }
+        ESSENTIALS_HOOK(count_kernel(view_op::rfind, view_kernel::scalar));
+        // candidates are the starting positions [0, n - m]
+        auto size = n - m + 1;
+        while(auto it = rfind_scan(hay, size, *needle)) {
+            if(Traits::eq(it[m - 1], needle[m - 1]) && Traits::compare(it + 1, needle + 1, m - 2) == 0)
+                return it;
+            ESSENTIALS_HOOK(count_mismatch(view_op::rfind));
+            size = size_t(it - hay);
+        }
+        return nullptr;
+    }
+};
+
+template<class Char, class Traits>
+struct kernels: scalar_kernels<Char, Traits> {};
+
+#ifdef ESSENTIALS_SIMD_X86
+/*
+ * Generic SIMD substring search: candidates are filtered on two anchor characters
+ * (the first one and the last one that differs from it) and verified with memcmp.
+ */
+template<>
+struct kernels<char, std::char_traits<char>>: scalar_kernels<char, std::char_traits<char>> {
+    static size_t anchor(const char* needle, size_t m) noexcept {
+        auto ix = m - 1;
+        while(ix > 1 && needle[ix] == needle[0]) --ix;
+        return ix;
+    }
+
+    static const char* find_tail(const char* hay, size_t n, const char* needle, size_t m, size_t i) noexcept {
+        for(; i + m <= n; ++i)
+            if(hay[i] == needle[0]) {
+                if(std::memcmp(hay + i + 1, needle + 1, m - 1) == 0) return hay + i;
+                ESSENTIALS_HOOK(count_mismatch(view_op::find));
+            }
+        return nullptr;
+    }
+
+    static const char* find_sse2(const char* hay, size_t n, const char* needle, size_t m) noexcept {
+        auto k = anchor(needle, m);
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i second = _mm_set1_epi8(needle[k]);
+        size_t i = 0;
+        for(; i + m + 15 <= n; i += 16) {
+            auto bf = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+            auto bs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + k));
+            auto mask = unsigned(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(second, bs))));
+            while(mask != 0) {
+                auto bit = size_t(__builtin_ctz(mask));
+                if(std::memcmp(hay + i + bit + 1, needle + 1, m - 1) == 0) return hay + i + bit;
+                ESSENTIALS_HOOK(count_mismatch(view_op::find));
+                mask &= mask - 1;
+            }
+        }
+        return find_tail(hay, n, needle, m, i);
+    }
+
+    __attribute__((target("avx2")))
+    static const char* find_avx2(const char* hay, size_t n, const char* needle, size_t m) noexcept {
+        auto k = anchor(needle, m);
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i second = _mm256_set1_epi8(needle[k]);
+        size_t i = 0;
+        for(; i + m + 31 <= n; i += 32) {
+            auto bf = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i));
+            auto bs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i + k));
+            auto mask = unsigned(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(second, bs))));
+            while(mask != 0) {
+                auto bit = size_t(__builtin_ctz(mask));
+                if(std::memcmp(hay + i + bit + 1, needle + 1, m - 1) == 0) return hay + i + bit;
+                ESSENTIALS_HOOK(count_mismatch(view_op::find));
+                mask &= mask - 1;
+            }
+        }
+        return find_sse2(hay + i, n - i, needle, m);
+    }
+
+    static const char* find(const char* hay, size_t n, const char* needle, size_t m) noexcept {
+        if(m == 1) {
+            ESSENTIALS_HOOK(count_kernel(view_op::find, view_kernel::library));
+            return static_cast<const char*>(std::memchr(hay, *needle, n));
+        }
+        if(m > two_way_threshold) {
+            ESSENTIALS_HOOK(count_kernel(view_op::find, view_kernel::two_way));
+            return two_way<char, std::char_traits<char>>(needle, m).find(hay, n);
+        }
+        if(cpu::has_avx2()) {
+            ESSENTIALS_HOOK(count_kernel(view_op::find, view_kernel::avx2));
+            return find_avx2(hay, n, needle, m);
+        }
+        ESSENTIALS_HOOK(count_kernel(view_op::find, view_kernel::sse2));
+        return find_sse2(hay, n, needle, m);
+    }
+
+    /*
+     * Reverse kernels mirror the forward ones: blocks are taken from the end
+     * and the highest set bit of a mask is the rightmost candidate.
+     */
+    static const char* rfind_sse2(const char* hay, size_t n, char needle) noexcept {
+        const __m128i pattern = _mm_set1_epi8(needle);
+        for(; n >= 16; n -= 16) {
+            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + n - 16));
+            auto mask = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+            if(mask != 0) return hay + n - 16 + (31 - __builtin_clz(mask));
+        }
+        return scalar_kernels::rfind_scan(hay, n, needle);
+    }
+
+    __attribute__((target("avx2")))
+    static const char* rfind_avx2(const char* hay, size_t n, char needle) noexcept {
+        const __m256i pattern = _mm256_set1_epi8(needle);
+        for(; n >= 64; n -= 64) {
+            auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + n - 32));
+            auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + n - 64));
+            auto hmask = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, pattern)));
+            auto lmask = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, pattern)));
+            if((hmask | lmask) != 0) {
+                if(hmask != 0) return hay + n - 32 + (31 - __builtin_clz(hmask));
+                return hay + n - 64 + (31 - __builtin_clz(lmask));
+            }
+        }
+        for(; n >= 32; n -= 32) {
+            auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + n - 32));
+            auto mask = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+            if(mask != 0) return hay + n - 32 + (31 - __builtin_clz(mask));
+        }
+        return rfind_sse2(hay, n, needle);
+    }
+
+    static const char* rfind(const char* hay, size_t n, char needle) noexcept {
+        if(cpu::has_avx2()) {
+            ESSENTIALS_HOOK(count_kernel(view_op::rfind, view_kernel::avx2));
+            return rfind_avx2(hay, n, needle);
+        }
+        ESSENTIALS_HOOK(count_kernel(view_op::rfind, view_kernel::sse2));
+        return rfind_sse2(hay, n, needle);
+    }
+
+    // candidates below `i + block` were not covered by the SIMD loop
+    static const char* rfind_head(const char* hay, const char* needle, size_t m, size_t count) noexcept {
+        while(count != 0) {
+            --count;
+            if(hay[count] == needle[0]) {
+                if(std::memcmp(hay + count + 1, needle + 1, m - 1) == 0) return hay + count;
+                ESSENTIALS_HOOK(count_mismatch(view_op::rfind));
+            }
+        }
+        return nullptr;
+    }
+
+    static const char* rfind_sse2(const char* hay, size_t n, const char* needle, size_t m) noexcept {
+        auto k = anchor(needle, m);
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i second = _mm_set1_epi8(needle[k]);
+        // number of candidate start positions still to check, [0, count)
+        auto count = n - m + 1;
+        for(; count >= 16; count -= 16) {
+            auto i = count - 16;
+            auto bf = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+            auto bs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + k));
+            auto mask = unsigned(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(second, bs))));
+            while(mask != 0) {
+                auto bit = size_t(31 - __builtin_clz(mask));
+                if(std::memcmp(hay + i + bit + 1, needle + 1, m - 1) == 0) return hay + i + bit;
+                ESSENTIALS_HOOK(count_mismatch(view_op::rfind));
+                mask ^= 1u << bit;
+            }
+        }
+        return rfind_head(hay, needle, m, count);
+    }
+
+    __attribute__((target("avx2")))
+    static const char* rfind_avx2(const char* hay, size_t n, const char* needle, size_t m) noexcept {
+        auto k = anchor(needle, m);
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i second = _mm256_set1_epi8(needle[k]);
+        auto count = n - m + 1;
+        for(; count >= 32; count -= 32) {
+            auto i = count - 32;
+            auto bf = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i));
+            auto bs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i + k));
+            auto mask = unsigned(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(second, bs))));
+            while(mask != 0) {
+                auto bit = size_t(31 - __builtin_clz(mask));
+                if(std::memcmp(hay + i + bit + 1, needle + 1, m - 1) == 0) return hay + i + bit;
+                ESSENTIALS_HOOK(count_mismatch(view_op::rfind));
+                mask ^= 1u << bit;
+            }
+        }
+        return rfind_sse2(hay, count + m - 1, needle, m);
+    }
+
+    static const char* rfind(const char* hay, size_t n, const char* needle, size_t m) noexcept {
+        if(m == 1) return rfind(hay, n, *needle);
+        if(m > two_way_threshold) {
+            ESSENTIALS_HOOK(count_kernel(view_op::rfind, view_kernel::two_way));
+            return two_way<char, std::char_traits<char>, true>(needle, m).find(hay, n);
+        }
+        if(cpu::has_avx2()) {
+            ESSENTIALS_HOOK(count_kernel(view_op::rfind, view_kernel::avx2));
+            return rfind_avx2(hay, n, needle, m);
+        }
+        ESSENTIALS_HOOK(count_kernel(view_op::rfind, view_kernel::sse2));
+        return rfind_sse2(hay, n, needle, m);
+    }
+};
+#endif
+
+#ifdef ESSENTIALS_SIMD_X86
+/*
+ * Byte classification against a 256-bit set (pshufb on both nibbles).
+ * table[0..15] holds, for every low nibble, the bits of high nibbles 0-7 in the set,
+ * table[16..31] the same for high nibbles 8-15.
+ * Masks have a bit set for every byte whose membership equals `member`.
+ */
+struct byte_class_kernels {
+    __attribute__((target("ssse3")))
+    static unsigned classify16(const uint8_t* table, const char* p, bool member) noexcept {
+        const __m128i lo_rows = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table));
+        const __m128i hi_rows = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16));
+        const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        auto rows = _mm_or_si128(_mm_shuffle_epi8(lo_rows, v), _mm_shuffle_epi8(hi_rows, _mm_xor_si128(v, _mm_set1_epi8(-128))));
+        auto bit = _mm_shuffle_epi8(bits, _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f)));
+        auto mask = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(rows, bit), bit)));
+        return member? mask : ~mask & 0xFFFFu;
+    }
+
+    __attribute__((target("avx2")))
+    static unsigned classify32(const uint8_t* table, const char* p, bool member) noexcept {
+        const __m256i lo_rows = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+        const __m256i hi_rows = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16)));
+        const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                              1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        auto rows = _mm256_or_si256(_mm256_shuffle_epi8(lo_rows, v), _mm256_shuffle_epi8(hi_rows, _mm256_xor_si256(v, _mm256_set1_epi8(-128))));
+        auto bit = _mm256_shuffle_epi8(bits, _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f)));
+        auto mask = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(rows, bit), bit)));
+        return member? mask : ~mask;
+    }
+
+    /*
+     * Block scans: on a hit return it, otherwise return nullptr and shrink [first, last)
+     * to the part that is left for the scalar tail.
+     */
+    __attribute__((target("avx2")))
+    static const char* find_first_avx2(const uint8_t* table, const char*& first, const char* last, bool member) noexcept {
+        for(; last - first >= 32; first += 32) {
+            auto mask = classify32(table, first, member);
+            if(mask != 0) return first + __builtin_ctz(mask);
+        }
+        return nullptr;
+    }
+
+    __attribute__((target("avx2")))
+    static const char* find_last_avx2(const uint8_t* table, const char* first, const char*& last, bool member) noexcept {
+        for(; last - first >= 32; last -= 32) {
+            auto mask = classify32(table, last - 32, member);
+            if(mask != 0) return last - 32 + (31 - __builtin_clz(mask));
+        }
+        return nullptr;
+    }
+
+    static const char* find_first(const uint8_t* table, const char*& first, const char* last, bool member) noexcept {
+        if(cpu::has_avx2()) {
+            if(auto res = find_first_avx2(table, first, last, member)) return res;
+        }
+        if(cpu::has_ssse3()) {
+            for(; last - first >= 16; first += 16) {
+                auto mask = classify16(table, first, member);
+                if(mask != 0) return first + __builtin_ctz(mask);
+            }
+        }
+        return nullptr;
+    }
+
+    static const char* find_last(const uint8_t* table, const char* first, const char*& last, bool member) noexcept {
+        if(cpu::has_avx2()) {
+            if(auto res = find_last_avx2(table, first, last, member)) return res;
+        }
+        if(cpu::has_ssse3()) {
+            for(; last - first >= 16; last -= 16) {
+                auto mask = classify16(table, last - 16, member);
+                if(mask != 0) return last - 16 + (31 - __builtin_clz(mask));
+            }
+        }
+        return nullptr;
+    }
+};
+#endif
+
+#ifdef ESSENTIALS_INSTRUMENT
+// the kernel a basic_char_set scan starts with
+template<class Char>
+inline view_kernel char_set_kernel() noexcept {
+#ifdef ESSENTIALS_SIMD_X86
+    if(sizeof(Char) == 1) return cpu::has_avx2()? view_kernel::avx2 : cpu::has_ssse3()? view_kernel::ssse3 : view_kernel::scalar;
+#endif
+    return view_kernel::scalar;
+}
+#endif
+
+} /* namespace detail */
+
 template<class Char, class Traits = std::char_traits<Char>>
+class basic_string_view;
+
+// see searcher.hpp
+template<class Char, class Traits>
+class basic_searcher;
+
+/*
+ * A set of characters built once and reused by the find_*_of family.
+ * Narrow characters get an exact 256-bit table (scanned with SIMD where available),
+ * wider ones a low-byte filter in front of a sorted array.
+ */
+template<class Char, class Traits = std::char_traits<Char>, bool Narrow = (sizeof(Char) == 1)>
+class basic_char_set;
+
+template<class Char, class Traits>
+class basic_char_set<Char, Traits, true> {
+    uint64_t bits_[4] = {};
+    // see detail::byte_class_kernels
+    uint8_t table_[32] = {};
+
+protected:
+    void insert_byte(unsigned char u) noexcept {
+        bits_[u >> 6] |= uint64_t(1) << (u & 63);
+        table_[(u & 15) + (u >> 7) * 16] |= uint8_t(1u << ((u >> 4) & 7));
+    }
+
+    bool test_byte(unsigned char u) const noexcept {
+        return (bits_[u >> 6] >> (u & 63)) & 1;
+    }
+
+public:
+    basic_char_set() noexcept = default;
+    basic_char_set(const Char* s, size_t size) noexcept {
+        if(detail::is_plain_traits<Char, Traits>::value) {
+            for(size_t ix = 0; ix < size; ++ix) insert_byte(static_cast<unsigned char>(s[ix]));
+            return;
+        }
+        for(unsigned u = 0; u < 256; ++u)
+            if(Traits::find(s, size, static_cast<Char>(u)) != nullptr) insert_byte(static_cast<unsigned char>(u));
+    }
+    basic_char_set(basic_string_view<Char, Traits> v) noexcept: basic_char_set(v.data(), v.size()) {}
+    basic_char_set(const Char* s) noexcept: basic_char_set(s, Traits::length(s)) {}
+
+    bool contains(Char c) const noexcept {
+        return test_byte(static_cast<unsigned char>(c));
+    }
+
+    const Char* find_first(const Char* first, const Char* last, bool member = true) const noexcept {
+#ifdef ESSENTIALS_SIMD_X86
+        auto cfirst = reinterpret_cast<const char*>(first);
+        auto found = detail::byte_class_kernels::find_first(table_, cfirst, reinterpret_cast<const char*>(last), member);
+        if(found) return reinterpret_cast<const Char*>(found);
+        first = reinterpret_cast<const Char*>(cfirst);
+#endif
+        for(; first != last; ++first)
+            if(contains(*first) == member) return first;
+        return nullptr;
+    }
+
+    const Char* find_last(const Char* first, const Char* last, bool member = true) const noexcept {
+#ifdef ESSENTIALS_SIMD_X86
+        auto clast = reinterpret_cast<const char*>(last);
+        auto found = detail::byte_class_kernels::find_last(table_, reinterpret_cast<const char*>(first), clast, member);
+        if(found) return reinterpret_cast<const Char*>(found);
+        last = reinterpret_cast<const Char*>(clast);
+#endif
+        while(last != first)
+            if(contains(*--last) == member) return last;
+        return nullptr;
+    }
+};
+
+template<class Char, class Traits>
+class basic_char_set<Char, Traits, false> {
+    // keyed by the low byte; every bit is set for traits that may fold different values together
+    uint64_t filter_[4] = {};
+    std::vector<Char> chars_;
+
+    static bool lt(Char lhv, Char rhv) noexcept { return Traits::lt(lhv, rhv); }
+    static bool eq(Char lhv, Char rhv) noexcept { return Traits::eq(lhv, rhv); }
+
+public:
+    basic_char_set() = default;
+    basic_char_set(const Char* s, size_t size): chars_(s, s + size) {
+        std::sort(chars_.begin(), chars_.end(), lt);
+        chars_.erase(std::unique(chars_.begin(), chars_.end(), eq), chars_.end());
+        if(!detail::is_plain_traits<Char, Traits>::value) {
+            for(auto&& word : filter_) word = ~uint64_t(0);
+            return;
+        }
+        for(auto c : chars_) {
+            auto u = size_t(c) & 0xFF;
+            filter_[u >> 6] |= uint64_t(1) << (u & 63);
+        }
+    }
+    basic_char_set(basic_string_view<Char, Traits> v): basic_char_set(v.data(), v.size()) {}
+    basic_char_set(const Char* s): basic_char_set(s, Traits::length(s)) {}
+
+    bool contains(Char c) const noexcept {
+        auto u = size_t(c) & 0xFF;
+        if(((filter_[u >> 6] >> (u & 63)) & 1) == 0) return false;
+        auto it = std::lower_bound(chars_.begin(), chars_.end(), c, lt);
+        return it != chars_.end() && eq(*it, c);
+    }
+
+    const Char* find_first(const Char* first, const Char* last, bool member = true) const noexcept {
+        for(; first != last; ++first)
+            if(contains(*first) == member) return first;
+        return nullptr;
+    }
+
+    const Char* find_last(const Char* first, const Char* last, bool member = true) const noexcept {
+        while(last != first)
+            if(contains(*--last) == member) return last;
+        return nullptr;
+    }
+};
+
+template<class Char, class Traits>
 class basic_string_view {
     const Char* data_ = nullptr;
     size_t size_ = 0;
@@ -25,6 +646,16 @@ class basic_string_view {
         return lhv < rhv? lhv : rhv;
     }
 
+    constexpr size_t index_of(const Char* found) const noexcept {
+        return (found == nullptr)? npos : size_t(found - data_);
+    }
+
+    // building a set is a couple of stores for plain (or fast_char_set) narrow traits;
+    // the wide set allocates, so wide views stay on the scan and a prebuilt char_set_type is the way in
+    static constexpr bool use_char_set(basic_string_view) noexcept {
+        return sizeof(Char) == 1 && detail::fast_char_set<Char, Traits>::value;
+    }
+
 public:
     using traits_type = Traits;
     using value_type = Char;
@@ -39,6 +670,7 @@ public:
     using reverse_iterator = const_reverse_iterator;
     using size_type = size_t;
     using difference_type = ptrdiff_t;
+    using char_set_type = basic_char_set<Char, Traits>;
 
     static constexpr size_type npos = ~size_type(0);
 
@@ -103,6 +735,8 @@ public:
 
     constexpr int compare(basic_string_view v) const noexcept {
         auto rlen = min(size_, v.size_);
+        ESSENTIALS_HOOK(count_call(view_op::compare, size_, v.size_, rlen));
+        ESSENTIALS_HOOK(count_kernel(view_op::compare, view_kernel::library));
         auto chcomp = Traits::compare(data_, v.data_, rlen);
         return (chcomp != 0)? chcomp : int(size_ - v.size_);
     }
@@ -131,20 +765,20 @@ public:
     constexpr size_type find(Char needle, size_type pos = 0) const {
         auto haystack = substr(pos);
         auto found = Traits::find(haystack.data_, haystack.size_, needle);
+        ESSENTIALS_HOOK(count_call(view_op::find, haystack.size_, 1, found? size_t(found - haystack.data_) + 1 : haystack.size_));
+        ESSENTIALS_HOOK(count_kernel(view_op::find, view_kernel::library));
         return (found == nullptr)? npos : size_type(found - data_);
     }
-    constexpr size_type find(basic_string_view needle, size_type pos = 0) const {
+    constexpr size_type find(basic_string_view needle, size_type pos = 0) const noexcept {
         if(pos >= size_) return npos;
         if(needle.empty()) return pos;
-        auto chars = needle.size();
-        while(true) {
-            if(pos >= size_) return npos;
-            auto pick = find(needle.front(), pos);
-            if(pick == npos || pick + chars > size_) return npos;
-            if(substr(pick, chars) == needle) return pick;
-            pos = pick + 1;
-        }
+        if(needle.size_ > size_ - pos) return npos;
+        auto res = index_of(detail::kernels<Char, Traits>::find(data_ + pos, size_ - pos, needle.data_, needle.size_));
+        ESSENTIALS_HOOK(count_call(view_op::find, size_ - pos, needle.size_, (res == npos)? size_ - pos : res - pos + needle.size_));
+        return res;
     }
+    // NON-STANDARD: defined in searcher.hpp
+    size_type find(const basic_searcher<Char, Traits>& searcher, size_type pos = 0) const noexcept;
     constexpr size_type find(const Char* s, size_type pos, size_type count) const {
         return find(basic_string_view(s, count), pos);
     }
@@ -152,24 +786,20 @@ public:
         return find(basic_string_view(s), pos);
     }
 
-    constexpr size_type rfind(Char needle, size_type pos = npos) const {
-        pos = min(pos, size_);
-        for(auto ix = size_type(0); ix < pos; ++ix)
-            if(Traits::eq(at(pos - ix - 1), needle))
-                return pos - ix - 1;
-        return npos;
+    constexpr size_type rfind(Char needle, size_type pos = npos) const noexcept {
+        if(empty()) return npos;
+        pos = min(pos, size_ - 1);
+        auto res = index_of(detail::kernels<Char, Traits>::rfind(data_, pos + 1, needle));
+        ESSENTIALS_HOOK(count_call(view_op::rfind, pos + 1, 1, (res == npos)? pos + 1 : pos + 1 - res));
+        return res;
     }
-    constexpr size_type rfind(basic_string_view needle, size_type pos = npos) const {
-        pos = min(pos, size_);
+    constexpr size_type rfind(basic_string_view needle, size_type pos = npos) const noexcept {
+        if(needle.size_ > size_) return npos;
+        pos = min(pos, size_ - needle.size_);
         if(needle.empty()) return pos;
-        auto chars = needle.size();
-        while(true) {
-            auto pick = rfind(needle.front(), pos);
-            if(pick == npos) return npos;
-            if(substr(pick, chars) == needle) return pick;
-            if(pick == 0) return npos;
-            pos = pick - 1;
-        }
+        auto res = index_of(detail::kernels<Char, Traits>::rfind(data_, pos + needle.size_, needle.data_, needle.size_));
+        ESSENTIALS_HOOK(count_call(view_op::rfind, pos + needle.size_, needle.size_, (res == npos)? pos + needle.size_ : pos + needle.size_ - res));
+        return res;
     }
     constexpr size_type rfind(const Char* s, size_type pos, size_type count) const {
         return rfind(basic_string_view(s, count), pos);
@@ -180,9 +810,19 @@ public:
 
     constexpr size_type find_first_of(basic_string_view v, size_type pos = 0) const noexcept {
         if(pos > size_) return npos;
-        for(auto ix = pos; ix < size_; ++ix)
-            if(v.find(operator[](ix)) != npos) return ix;
-        return npos;
+        if(use_char_set(v)) return find_first_of(char_set_type(v), pos);
+        auto ix = pos;
+        while(ix < size_ && Traits::find(v.data_, v.size_, data_[ix]) == nullptr) ++ix;
+        ESSENTIALS_HOOK(count_call(view_op::find_first_of, size_ - pos, v.size_, (ix < size_)? ix - pos + 1 : size_ - pos));
+        ESSENTIALS_HOOK(count_kernel(view_op::find_first_of, view_kernel::scalar));
+        return (ix < size_)? ix : npos;
+    }
+    size_type find_first_of(const char_set_type& set, size_type pos = 0) const noexcept {
+        if(pos >= size_) return npos;
+        auto res = index_of(set.find_first(data_ + pos, data_ + size_, true));
+        ESSENTIALS_HOOK(count_call(view_op::find_first_of, size_ - pos, 0, (res == npos)? size_ - pos : res - pos + 1));
+        ESSENTIALS_HOOK(count_kernel(view_op::find_first_of, detail::char_set_kernel<Char>()));
+        return res;
     }
     constexpr size_type find_first_of(Char c, size_type pos = 0) const noexcept {
         return find(c, pos);
@@ -195,12 +835,23 @@ public:
     }
 
     constexpr size_type find_last_of(basic_string_view v, size_type pos = npos) const noexcept {
+        if(use_char_set(v)) return find_last_of(char_set_type(v), pos);
         pos = min(size_ - 1, pos);
-        // we cannot use "pos > 0" here, cos pos is unsigned,
+        auto ix = pos;
+        // we cannot use "ix > 0" here, cos ix is unsigned,
         // so we bet on underflow
-        for(;pos < size_;--pos)
-            if(v.find(operator[](pos)) != npos) return pos;
-        return npos;
+        while(ix < size_ && Traits::find(v.data_, v.size_, data_[ix]) == nullptr) --ix;
+        ESSENTIALS_HOOK(count_call(view_op::find_last_of, empty()? 0 : pos + 1, v.size_, (ix < size_)? pos + 1 - ix : (empty()? 0 : pos + 1)));
+        ESSENTIALS_HOOK(count_kernel(view_op::find_last_of, view_kernel::scalar));
+        return (ix < size_)? ix : npos;
+    }
+    size_type find_last_of(const char_set_type& set, size_type pos = npos) const noexcept {
+        if(empty()) return npos;
+        pos = min(size_ - 1, pos);
+        auto res = index_of(set.find_last(data_, data_ + pos + 1, true));
+        ESSENTIALS_HOOK(count_call(view_op::find_last_of, pos + 1, 0, (res == npos)? pos + 1 : pos + 1 - res));
+        ESSENTIALS_HOOK(count_kernel(view_op::find_last_of, detail::char_set_kernel<Char>()));
+        return res;
     }
     constexpr size_type find_last_of(Char c, size_type pos = npos) const noexcept {
         return rfind(c, pos);
@@ -214,9 +865,19 @@ public:
 
     constexpr size_type find_first_not_of(basic_string_view v, size_type pos = 0) const noexcept {
         if(pos > size_) return npos;
-        for(auto ix = pos; ix < size_; ++ix)
-            if(v.find(operator[](ix)) == npos) return ix;
-        return npos;
+        if(use_char_set(v)) return find_first_not_of(char_set_type(v), pos);
+        auto ix = pos;
+        while(ix < size_ && Traits::find(v.data_, v.size_, data_[ix]) != nullptr) ++ix;
+        ESSENTIALS_HOOK(count_call(view_op::find_first_not_of, size_ - pos, v.size_, (ix < size_)? ix - pos + 1 : size_ - pos));
+        ESSENTIALS_HOOK(count_kernel(view_op::find_first_not_of, view_kernel::scalar));
+        return (ix < size_)? ix : npos;
+    }
+    size_type find_first_not_of(const char_set_type& set, size_type pos = 0) const noexcept {
+        if(pos >= size_) return npos;
+        auto res = index_of(set.find_first(data_ + pos, data_ + size_, false));
+        ESSENTIALS_HOOK(count_call(view_op::find_first_not_of, size_ - pos, 0, (res == npos)? size_ - pos : res - pos + 1));
+        ESSENTIALS_HOOK(count_kernel(view_op::find_first_not_of, detail::char_set_kernel<Char>()));
+        return res;
     }
     constexpr size_type find_first_not_of(Char c, size_type pos = 0) const noexcept {
         return find_first_not_of(basic_string_view(&c, 1), pos);
@@ -229,19 +890,30 @@ public:
     }
 
     constexpr size_type find_last_not_of(basic_string_view v, size_type pos = npos) const noexcept {
+        if(use_char_set(v)) return find_last_not_of(char_set_type(v), pos);
         pos = min(size_ - 1, pos);
-        // we cannot use "pos > 0" here, cos pos is unsigned,
+        auto ix = pos;
+        // we cannot use "ix > 0" here, cos ix is unsigned,
         // so we bet on underflow
-        for(;pos < size_;--pos)
-            if(v.find(operator[](pos)) == npos) return pos;
-        return npos;
+        while(ix < size_ && Traits::find(v.data_, v.size_, data_[ix]) != nullptr) --ix;
+        ESSENTIALS_HOOK(count_call(view_op::find_last_not_of, empty()? 0 : pos + 1, v.size_, (ix < size_)? pos + 1 - ix : (empty()? 0 : pos + 1)));
+        ESSENTIALS_HOOK(count_kernel(view_op::find_last_not_of, view_kernel::scalar));
+        return (ix < size_)? ix : npos;
+    }
+    size_type find_last_not_of(const char_set_type& set, size_type pos = npos) const noexcept {
+        if(empty()) return npos;
+        pos = min(size_ - 1, pos);
+        auto res = index_of(set.find_last(data_, data_ + pos + 1, false));
+        ESSENTIALS_HOOK(count_call(view_op::find_last_not_of, pos + 1, 0, (res == npos)? pos + 1 : pos + 1 - res));
+        ESSENTIALS_HOOK(count_kernel(view_op::find_last_not_of, detail::char_set_kernel<Char>()));
+        return res;
     }
     constexpr size_type find_last_not_of(Char c, size_type pos = npos) const noexcept {
         return find_last_not_of(basic_string_view(&c, 1), pos);
     }
-        constexpr size_type find_last_not_of(const Char* s, size_type pos, size_type count) const {
-            return find_last_not_of(basic_string_view(s, count), pos);
-        }
+    constexpr size_type find_last_not_of(const Char* s, size_type pos, size_type count) const {
+        return find_last_not_of(basic_string_view(s, count), pos);
+    }
     constexpr size_type find_last_not_of(const Char* s, size_type pos = npos) const {
         return find_last_not_of(basic_string_view(s), pos);
     }
@@ -269,13 +941,20 @@ public:
     }
 };
 
+template<class Char, class Traits>
+constexpr typename basic_string_view<Char, Traits>::size_type basic_string_view<Char, Traits>::npos;
+
 template<class Char, class Traits>
 std::basic_ostream<Char, Traits>& operator<<(std::basic_ostream<Char, Traits>& os, basic_string_view<Char, Traits> v) {
     auto width = os.width();
     auto size = v.size();
     auto left = (os.flags() & os.adjustfield) == os.left;
+    // fill characters go out in blocks rather than through a formatted insert per pad
     auto putfill = [](std::basic_ostream<Char, Traits>& os, size_t amount) {
-        os.width(amount); os << "";
+        Char block[64];
+        Traits::assign(block, 64, os.fill());
+        for(; amount > 64; amount -= 64) os.write(block, 64);
+        os.write(block, std::streamsize(amount));
     };
     if(size < size_t(width)) {
         auto diff = width - size;
@@ -293,6 +972,11 @@ constexpr basic_string_view<char> operator"" _sv(const char* s, size_t len) { re
 
 using string_view = basic_string_view<char>;
 using wstring_view = basic_string_view<wchar_t>;
+using u16string_view = basic_string_view<char16_t>;
+using u32string_view = basic_string_view<char32_t>;
+
+using char_set = basic_char_set<char>;
+using wchar_set = basic_char_set<wchar_t>;
 
 } /* namespace essentials */
 
@@ -314,28 +998,208 @@ namespace fnv {
     };
 } /* namespace fnv */
 
-namespace std {
-    template<>
-    struct hash<essentials::string_view> {
-        size_t operator()(essentials::string_view sv) const noexcept {
-            /* fnv hash */
-            size_t hash = fnv::fnv<>::offset;
-            for(char c : sv) {
-                hash *= fnv::fnv<>::base;
-                hash ^= size_t(c);
+namespace essentials {
+
+namespace detail {
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+template<class Char>
+constexpr uint64_t code_unit(Char c) noexcept {
+    return uint64_t(static_cast<typename std::make_unsigned<Char>::type>(c));
+}
+
+// the low bytes of code units data[Ix...] packed little-endian; the flat or-expression folds into one load
+template<class Char, size_t... Ix>
+constexpr uint64_t load_units(const Char* data, std::index_sequence<Ix...>) noexcept {
+    uint64_t res = 0;
+    using expand = int[];
+    (void) expand{ 0, (res |= (code_unit(data[Ix]) & 0xFF) << (8 * Ix), 0)... };
+    return res;
+}
+
+/*
+ * Little-endian view over a code unit sequence, one byte per unit: its low one.
+ * For narrow units that is the bytes themselves; wider units with values past a byte
+ * carry the rest in high_reader. Assembling words with shifts keeps hashing constexpr.
+ */
+template<class Char>
+class byte_reader {
+    const Char* data_;
+
+public:
+    constexpr explicit byte_reader(const Char* data) noexcept: data_(data) {}
+
+    constexpr uint64_t byte(size_t off) const noexcept { return code_unit(data_[off]) & 0xFF; }
+    constexpr uint64_t r4(size_t off) const noexcept { return load_units(data_ + off, std::make_index_sequence<4>()); }
+    constexpr uint64_t r8(size_t off) const noexcept { return load_units(data_ + off, std::make_index_sequence<8>()); }
+};
+
+// what byte_reader leaves out: four bytes per unit holding its value shifted down by a byte
+template<class Char>
+class high_reader {
+    const Char* data_;
+
+public:
+    constexpr explicit high_reader(const Char* data) noexcept: data_(data) {}
+
+    constexpr uint64_t byte(size_t off) const noexcept { return (code_unit(data_[off / 4]) >> (8 + 8 * (off % 4))) & 0xFF; }
+    // word reads only ever start at a unit, hash_bytes asks for multiples of four on a multiple of four
+    constexpr uint64_t r4(size_t off) const noexcept { return (code_unit(data_[off / 4]) >> 8) & 0xFFFFFFFF; }
+    constexpr uint64_t r8(size_t off) const noexcept { return r4(off) | (r4(off + 4) << 32); }
+};
+
+template<class Char>
+constexpr bool has_high_units(const Char* data, size_t size) noexcept {
+    uint64_t high = 0;
+    for(size_t ix = 0; ix < size; ++ix) high |= code_unit(data[ix]) >> 8;
+    return high != 0;
+}
+
+// 64x64 -> 128 multiply, low half into lhv and high half into rhv
+constexpr void mum(uint64_t& lhv, uint64_t& rhv) noexcept {
+#ifdef __SIZEOF_INT128__
+    auto res = uint128_t(lhv) * rhv;
+    lhv = uint64_t(res);
+    rhv = uint64_t(res >> 64);
+#else
+    uint64_t ha = lhv >> 32, hb = rhv >> 32, la = uint32_t(lhv), lb = uint32_t(rhv);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), carry = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    lhv = lo;
+    rhv = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+constexpr uint64_t mix(uint64_t lhv, uint64_t rhv) noexcept {
+    mum(lhv, rhv);
+    return lhv ^ rhv;
+}
+
+} /* namespace detail */
+
+/*
+ * Hash policies: `hash(data, size, seed)` over the values of `size` code units.
+ * Views of the same code unit values hash the same whatever their Char is: "abc", u"abc" and U"abc" agree.
+ * The low byte of every unit is hashed first, a narrow view stops there; a wider one with units
+ * past 0xFF goes on to hash the rest of every unit (see detail::high_reader), seeded with the first result.
+ * Policies hash raw code units, so they only agree with equality for bitwise traits.
+ */
+
+// wyhash-style: 16 bytes per step (48 in the long loop), a single 64x64->128 multiply per mix
+struct wyhash_policy {
+    template<class Char>
+    static constexpr uint64_t hash(const Char* data, size_t size, uint64_t seed) noexcept {
+        auto res = hash_bytes(detail::byte_reader<Char>(data), size, seed);
+        if(sizeof(Char) > 1 && detail::has_high_units(data, size))
+            res = hash_bytes(detail::high_reader<Char>(data), 4 * size, res);
+        return res;
+    }
+
+    // the same over any reader with byte, r4 and r8 (see detail::byte_reader)
+    template<class Reader>
+    static constexpr uint64_t hash_bytes(Reader p, size_t len, uint64_t seed) noexcept {
+        constexpr uint64_t s0 = 0x2d358dccaa6c78a5ULL;
+        constexpr uint64_t s1 = 0x8bb84b93962eacc9ULL;
+        constexpr uint64_t s2 = 0x4b33a62ed433d4a3ULL;
+        constexpr uint64_t s3 = 0x4d5a2da51de1aa47ULL;
+
+        uint64_t a = 0, b = 0;
+        seed ^= detail::mix(seed ^ s0, s1);
+        if(len <= 16) {
+            if(len >= 4) {
+                auto shift = (len >> 3) << 2;
+                a = (p.r4(0) << 32) | p.r4(shift);
+                b = (p.r4(len - 4) << 32) | p.r4(len - 4 - shift);
+            } else if(len > 0) {
+                a = (p.byte(0) << 16) | (p.byte(len >> 1) << 8) | p.byte(len - 1);
+            }
+        } else {
+            size_t off = 0, left = len;
+            if(left > 48) {
+                auto see1 = seed, see2 = seed;
+                do {
+                    seed = detail::mix(p.r8(off) ^ s1, p.r8(off + 8) ^ seed);
+                    see1 = detail::mix(p.r8(off + 16) ^ s2, p.r8(off + 24) ^ see1);
+                    see2 = detail::mix(p.r8(off + 32) ^ s3, p.r8(off + 40) ^ see2);
+                    off += 48;
+                    left -= 48;
+                } while(left > 48);
+                seed ^= see1 ^ see2;
+            }
+            while(left > 16) {
+                seed = detail::mix(p.r8(off) ^ s1, p.r8(off + 8) ^ seed);
+                off += 16;
+                left -= 16;
             }
-            return hash;
+            a = p.r8(len - 16);
+            b = p.r8(len - 8);
         }
-    };
+        a ^= s1;
+        b ^= seed;
+        detail::mum(a, b);
+        return detail::mix(a ^ s0 ^ len, b ^ s1);
+    }
+};
 
-    template<>
-    struct hash<essentials::wstring_view> {
-        constexpr size_t operator()(essentials::wstring_view sv) const noexcept {
-            /* djb2 hash */
-            size_t hash = 5381;
-            for(auto&& c: sv)
-                hash = hash * 33 + (size_t)c;
-            return hash;
+// byte-at-a-time FNV-1a over the same byte sequence, a quality baseline
+struct fnv1a_policy {
+    template<class Char>
+    static constexpr uint64_t hash(const Char* data, size_t size, uint64_t seed) noexcept {
+        auto hash = hash_bytes(detail::byte_reader<Char>(data), size, fnv::fnv<8>::offset ^ seed);
+        if(sizeof(Char) > 1 && detail::has_high_units(data, size))
+            hash = hash_bytes(detail::high_reader<Char>(data), 4 * size, hash);
+        return hash;
+    }
+
+    template<class Reader>
+    static constexpr uint64_t hash_bytes(Reader p, size_t len, uint64_t hash) noexcept {
+        for(size_t ix = 0; ix < len; ++ix) {
+            hash ^= p.byte(ix);
+            hash *= fnv::fnv<8>::base;
         }
-    };
+        return hash;
+    }
+};
+
+template<class Char, class Traits = std::char_traits<Char>, class Policy = wyhash_policy>
+class basic_string_view_hash {
+    uint64_t seed_ = 0;
+
+public:
+    constexpr basic_string_view_hash() noexcept = default;
+    // a random per-process seed (see random_hash_seed) makes hash flooding impractical
+    constexpr explicit basic_string_view_hash(uint64_t seed) noexcept: seed_(seed) {}
+
+    constexpr uint64_t seed() const noexcept { return seed_; }
+
+    constexpr size_t operator()(basic_string_view<Char, Traits> v) const noexcept {
+        ESSENTIALS_HOOK(count_call(view_op::hash, v.size(), 0, v.size()));
+        ESSENTIALS_HOOK(count_kernel(view_op::hash, view_kernel::scalar));
+        return size_t(Policy::hash(v.data(), v.size(), seed_));
+    }
+};
+
+inline uint64_t random_hash_seed() {
+    static const uint64_t seed = [] {
+        std::random_device rd;
+        return (uint64_t(rd()) << 32) ^ rd();
+    }();
+    return seed;
+}
+
+using string_view_hash = basic_string_view_hash<char>;
+using wstring_view_hash = basic_string_view_hash<wchar_t>;
+
+} /* namespace essentials */
+
+namespace std {
+    template<class Char>
+    struct hash<essentials::basic_string_view<Char>>: essentials::basic_string_view_hash<Char> {};
 } /* namespace std */
+
+#endif /* ESSENTIALS_STRING_VIEW_HPP */
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <string>
+#include <strings.h>
+
+#include "bench_common.hpp"
+#include "ci_string_view.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // mixed-case text, the needle planted at the end in a different case than searched for
+    struct ci_data {
+        std::string hay;
+
+        explicit ci_data(size_t size): hay(bench::text(size, 64)) {
+            if(size >= 14) hay.replace(size - 14, 14, "Content-Length");
+        }
+    };
+
+    void ci_find(benchmark::State& state) {
+        ci_data data(size_t(state.range(0)));
+        auto hay = as_ci(data.hay);
+        for(auto _ : state) benchmark::DoNotOptimize(hay.find("CONTENT-LENGTH"));
+        bench::set_bytes(state, data.hay.size());
+    }
+
+    void ci_find_lowercase_copy(benchmark::State& state) {
+        ci_data data(size_t(state.range(0)));
+        for(auto _ : state) {
+            std::string copy = data.hay;
+            std::transform(copy.begin(), copy.end(), copy.begin(), [](char c) { return ci_char_traits::fold(c); });
+            benchmark::DoNotOptimize(copy.find("content-length"));
+        }
+        bench::set_bytes(state, data.hay.size());
+    }
+
+    void ci_find_strcasestr(benchmark::State& state) {
+        ci_data data(size_t(state.range(0)));
+        for(auto _ : state) benchmark::DoNotOptimize(strcasestr(data.hay.c_str(), "CONTENT-LENGTH"));
+        bench::set_bytes(state, data.hay.size());
+    }
+
+    void ci_compare(benchmark::State& state) {
+        ci_data data(size_t(state.range(0)));
+        std::string upper = data.hay;
+        std::transform(upper.begin(), upper.end(), upper.begin(), [](char c) { return (c >= 'a' && c <= 'z')? char(c - 32) : c; });
+        for(auto _ : state) benchmark::DoNotOptimize(as_ci(data.hay).compare(as_ci(upper)));
+        bench::set_bytes(state, data.hay.size());
+    }
+
+    void ci_compare_strncasecmp(benchmark::State& state) {
+        ci_data data(size_t(state.range(0)));
+        std::string upper = data.hay;
+        std::transform(upper.begin(), upper.end(), upper.begin(), [](char c) { return (c >= 'a' && c <= 'z')? char(c - 32) : c; });
+        for(auto _ : state) benchmark::DoNotOptimize(strncasecmp(data.hay.c_str(), upper.c_str(), upper.size()));
+        bench::set_bytes(state, data.hay.size());
+    }
+
+    void ci_find_first_of(benchmark::State& state) {
+        ci_data data(size_t(state.range(0)));
+        auto hay = as_ci(data.hay);
+        for(auto _ : state) benchmark::DoNotOptimize(hay.find_first_of("#!-"));
+        bench::set_bytes(state, data.hay.size());
+    }
+
+    void ci_hash(benchmark::State& state) {
+        ci_data data(size_t(state.range(0)));
+        std::hash<ci_string_view> hasher;
+        for(auto _ : state) benchmark::DoNotOptimize(hasher(as_ci(data.hay)));
+        bench::set_bytes(state, data.hay.size());
+    }
+
+    BENCHMARK(ci_find)->Apply(bench::sizes);
+    BENCHMARK(ci_find_lowercase_copy)->Apply(bench::sizes);
+    BENCHMARK(ci_find_strcasestr)->Apply(bench::sizes);
+    BENCHMARK(ci_compare)->Apply(bench::sizes);
+    BENCHMARK(ci_compare_strncasecmp)->Apply(bench::sizes);
+    BENCHMARK(ci_find_first_of)->Apply(bench::sizes);
+    BENCHMARK(ci_hash)->Apply(bench::sizes);
+}
@@ -0,0 +1,80 @@
+#ifndef STRING_VIEW_BENCH_COMMON_HPP
+#define STRING_VIEW_BENCH_COMMON_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#ifndef STRING_VIEW_BENCH_MAX_SIZE
+# define STRING_VIEW_BENCH_MAX_SIZE (size_t(16) << 20)
+#endif
+
+namespace bench {
+
+    // the largest haystack of the sweeps, STRING_VIEW_BENCH_MAX_SIZE in the environment overrides the build default
+    inline size_t max_size() {
+        static const size_t size = [] {
+            auto env = std::getenv("STRING_VIEW_BENCH_MAX_SIZE");
+            auto parsed = (env != nullptr)? std::strtoull(env, nullptr, 0) : 0;
+            return (parsed != 0)? size_t(parsed) : size_t(STRING_VIEW_BENCH_MAX_SIZE);
+        }();
+        return size;
+    }
+
+    /*
+     * Deterministic text over `alphabet` characters starting at '0' (at most 64 of them, so up to 'o').
+     * The alphabet size stands for the entropy of the data: 2 is close to a bitmap, 64 to plain text.
+     * '#' never occurs and serves as the sentinel of needles that must match only where they are planted.
+     */
+    inline std::string text(size_t size, size_t alphabet, uint64_t seed = 0) {
+        std::string res(size, '0');
+        uint64_t state = 0x9E3779B97F4A7C15ull ^ (seed * 64 + alphabet);
+        for(auto&& c : res) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            c = char('0' + (state >> 32) % alphabet);
+        }
+        return res;
+    }
+
+    // a needle of `size` haystack-like characters with the sentinel in the middle, so its ends still look like the text
+    inline std::string needle(size_t size, size_t alphabet) {
+        auto res = text(size, alphabet, 1);
+        if(!res.empty()) res[res.size() / 2] = '#';
+        return res;
+    }
+
+    // haystack of `size` bytes with `needle` planted at its very end
+    inline std::string haystack(size_t size, size_t alphabet, const std::string& needle) {
+        auto res = text(size, alphabet);
+        if(needle.size() <= size) res.replace(size - needle.size(), needle.size(), needle);
+        return res;
+    }
+
+    // sizes 16 B .. max_size() in steps of x8, the max itself included
+    inline void sizes(benchmark::internal::Benchmark* b) {
+        size_t size = 16;
+        for(; size < max_size(); size *= 8) b->Arg(int64_t(size));
+        b->Arg(int64_t(max_size()));
+    }
+
+    // sizes x needle sizes x alphabets, for the substring searches
+    inline void needle_sweep(benchmark::internal::Benchmark* b) {
+        for(size_t alphabet : { 2, 8, 64 })
+            for(size_t needle : { 4, 16, 64, 256 }) {
+                size_t size = 1024;
+                for(; size < max_size(); size *= 32) b->Args({ int64_t(size), int64_t(needle), int64_t(alphabet) });
+                b->Args({ int64_t(max_size()), int64_t(needle), int64_t(alphabet) });
+            }
+    }
+
+    inline void set_bytes(benchmark::State& state, size_t bytes) {
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(bytes));
+    }
+
+} /* namespace bench */
+
+#endif /* STRING_VIEW_BENCH_COMMON_HPP */
@@ -0,0 +1,59 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "bench_common.hpp"
+#include "csv_scanner.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // an ingest-like export: ids, numbers, short names and now and then a quoted free-text column
+    std::string make_csv(size_t size) {
+        std::string res;
+        for(size_t row = 0; res.size() < size; ++row) {
+            res += std::to_string(row) + "," + std::to_string(row * 7919 % 100000) + ".25,user" + std::to_string(row % 1000) + ",";
+            if(row % 4 == 0) res += "\"free text, with a comma and \"\"quotes\"\"\"";
+            else res += "plain text";
+            res += ",2024-01-01T00:00:00Z\r\n";
+        }
+        return res;
+    }
+
+    void csv_scanner_fields(benchmark::State& state) {
+        auto data = make_csv(size_t(state.range(0)));
+        for(auto _ : state) {
+            csv_scanner scanner(data);
+            size_t fields = 0;
+            while(scanner.next()) fields += scanner.record().size();
+            benchmark::DoNotOptimize(fields);
+        }
+        bench::set_bytes(state, data.size());
+    }
+
+    // what the ingest job does today: find_first_of from field to field, skipping quoted runs
+    void find_first_of_fields(benchmark::State& state) {
+        auto data = make_csv(size_t(state.range(0)));
+        string_view v = data;
+        for(auto _ : state) {
+            size_t fields = 0;
+            for(size_t pos = 0; pos < v.size();) {
+                auto end = v.find_first_of("\",\n", pos);
+                if(end == string_view::npos) break;
+                if(v[end] == '"') {
+                    // to the closing quote, doubled ones included
+                    do end = v.find('"', end + 1) + 1; while(end < v.size() && v[end] == '"');
+                    pos = end;
+                    continue;
+                }
+                ++fields;
+                pos = end + 1;
+            }
+            benchmark::DoNotOptimize(fields);
+        }
+        bench::set_bytes(state, data.size());
+    }
+
+    BENCHMARK(csv_scanner_fields)->Arg(1 << 16)->Arg(1 << 24);
+    BENCHMARK(find_first_of_fields)->Arg(1 << 16)->Arg(1 << 24);
+}
@@ -0,0 +1,52 @@
+#include <cstring>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include "string_view.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // JSON-ish log line haystack where the needle's first character is very common
+    std::string make_haystack(size_t size) {
+        static const char chunk[] = "{\"id\":\"12\",\"user\":\"x\",\"path\":\"/a/b\",\"code\":\"200\"},";
+        std::string res;
+        while(res.size() < size) res += chunk;
+        res.resize(size);
+        return res;
+    }
+
+    const char needle[] = "\"status\"";
+
+    void find_string_view(benchmark::State& state) {
+        auto hay = make_haystack(size_t(state.range(0)));
+        string_view vh = hay;
+        for(auto _ : state) benchmark::DoNotOptimize(vh.find(needle));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(hay.size()));
+    }
+
+    void find_memmem(benchmark::State& state) {
+        auto hay = make_haystack(size_t(state.range(0)));
+        for(auto _ : state) benchmark::DoNotOptimize(memmem(hay.data(), hay.size(), needle, sizeof(needle) - 1));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(hay.size()));
+    }
+
+    void find_std_string(benchmark::State& state) {
+        auto hay = make_haystack(size_t(state.range(0)));
+        for(auto _ : state) benchmark::DoNotOptimize(hay.find(needle));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(hay.size()));
+    }
+
+    void find_long_needle(benchmark::State& state) {
+        auto hay = make_haystack(size_t(state.range(0)));
+        std::string long_needle(100, 'a');
+        string_view vh = hay;
+        for(auto _ : state) benchmark::DoNotOptimize(vh.find(long_needle));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(hay.size()));
+    }
+
+    BENCHMARK(find_string_view)->Range(64, 1 << 20);
+    BENCHMARK(find_memmem)->Range(64, 1 << 20);
+    BENCHMARK(find_std_string)->Range(64, 1 << 20);
+    BENCHMARK(find_long_needle)->Range(64, 1 << 20);
+}
@@ -0,0 +1,75 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include "string_view.hpp"
+
+namespace {
+    using namespace essentials;
+
+    const char separators[] = " \t\r\n,;";
+
+    // long tokens, so the scan spends its time between separators
+    std::string make_text(size_t size) {
+        static const char chunk[] = "alphabetagammadeltaepsilonzetaetatheta;";
+        std::string res;
+        while(res.size() < size) res += chunk;
+        res.resize(size);
+        res.back() = ',';
+        return res;
+    }
+
+    void find_first_of_view(benchmark::State& state) {
+        auto text = make_text(size_t(state.range(0)));
+        string_view vt = text;
+        for(auto _ : state) {
+            size_t pos = 0, count = 0;
+            while((pos = vt.find_first_of(separators, pos)) != string_view::npos) { ++pos; ++count; }
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(text.size()));
+    }
+
+    void find_first_of_char_set(benchmark::State& state) {
+        auto text = make_text(size_t(state.range(0)));
+        string_view vt = text;
+        char_set set = separators;
+        for(auto _ : state) {
+            size_t pos = 0, count = 0;
+            while((pos = vt.find_first_of(set, pos)) != string_view::npos) { ++pos; ++count; }
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(text.size()));
+    }
+
+    void find_first_of_std_string(benchmark::State& state) {
+        auto text = make_text(size_t(state.range(0)));
+        for(auto _ : state) {
+            size_t pos = 0, count = 0;
+            while((pos = text.find_first_of(separators, pos)) != std::string::npos) { ++pos; ++count; }
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(text.size()));
+    }
+
+    void find_last_not_of_char_set(benchmark::State& state) {
+        std::string text(size_t(state.range(0)), ' ');
+        text[0] = 'x';
+        string_view vt = text;
+        char_set set = separators;
+        for(auto _ : state) benchmark::DoNotOptimize(vt.find_last_not_of(set));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(text.size()));
+    }
+
+    void find_last_not_of_std_string(benchmark::State& state) {
+        std::string text(size_t(state.range(0)), ' ');
+        text[0] = 'x';
+        for(auto _ : state) benchmark::DoNotOptimize(text.find_last_not_of(separators));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(text.size()));
+    }
+
+    BENCHMARK(find_first_of_view)->Range(64, 1 << 20);
+    BENCHMARK(find_first_of_char_set)->Range(64, 1 << 20);
+    BENCHMARK(find_first_of_std_string)->Range(64, 1 << 20);
+    BENCHMARK(find_last_not_of_char_set)->Range(64, 1 << 20);
+    BENCHMARK(find_last_not_of_std_string)->Range(64, 1 << 20);
+}
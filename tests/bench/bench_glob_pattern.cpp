@@ -0,0 +1,106 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "glob_pattern.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // what the access rules are matched with today: recursion over substr and find
+    bool recursive_match(string_view p, string_view s) {
+        if(p.empty()) return s.empty();
+        if(p[0] == '*') {
+            for(size_t at = 0; at <= s.size(); ++at)
+                if(recursive_match(p.substr(1), s.substr(at))) return true;
+            return false;
+        }
+        if(s.empty() || (p[0] != '?' && p[0] != s[0])) return false;
+        return recursive_match(p.substr(1), s.substr(1));
+    }
+
+    std::vector<std::string> make_rules(size_t count) {
+        std::vector<std::string> res;
+        for(size_t i = 0; res.size() < count; ++i) {
+            res.push_back("*.tenant" + std::to_string(i) + ".example.com");
+            if(res.size() < count) res.push_back("/api/v" + std::to_string(i % 4) + "/*/items" + std::to_string(i) + "?");
+            if(res.size() < count) res.push_back("/static/*/bundle" + std::to_string(i) + "*.js");
+        }
+        return res;
+    }
+
+    std::vector<std::string> make_inputs() {
+        std::vector<std::string> res;
+        for(size_t i = 0; i < 256; ++i) {
+            switch(i % 4) {
+            case 0: res.push_back("www.tenant" + std::to_string(i % 40) + ".example.com"); break;
+            case 1: res.push_back("/api/v" + std::to_string(i % 4) + "/users/" + std::to_string(i) + "/items" + std::to_string(i % 40) + "/"); break;
+            case 2: res.push_back("/static/app/chunks/bundle" + std::to_string(i % 40) + ".min.js"); break;
+            default: res.push_back("/unmatched/path/" + std::to_string(i) + "/with/some/length/to/it"); break;
+            }
+        }
+        return res;
+    }
+
+    void glob_pattern_match(benchmark::State& state) {
+        glob_pattern host("*.tenant7.example.com");
+        glob_pattern route("/api/*/items7?");
+        auto inputs = make_inputs();
+        for(auto _ : state)
+            for(auto&& s : inputs) benchmark::DoNotOptimize(host.match(s) || route.match(s));
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(inputs.size()));
+    }
+
+    void recursive_glob_match(benchmark::State& state) {
+        auto inputs = make_inputs();
+        for(auto _ : state)
+            for(auto&& s : inputs)
+                benchmark::DoNotOptimize(recursive_match("*.tenant7.example.com", s) || recursive_match("/api/*/items7?", s));
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(inputs.size()));
+    }
+
+    // several stars against a long input that almost matches
+    void glob_pattern_adversarial(benchmark::State& state) {
+        std::string input(size_t(state.range(0)), 'a');
+        glob_pattern pattern("*a*a*a*a*b");
+        for(auto _ : state) benchmark::DoNotOptimize(pattern.match(input));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+    }
+
+    void recursive_glob_adversarial(benchmark::State& state) {
+        std::string input(size_t(state.range(0)), 'a');
+        for(auto _ : state) benchmark::DoNotOptimize(recursive_match("*a*a*a*a*b", input));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+    }
+
+    void glob_set_match(benchmark::State& state) {
+        auto rules = make_rules(size_t(state.range(0)));
+        glob_set set(rules.begin(), rules.end());
+        auto inputs = make_inputs();
+        for(auto _ : state)
+            for(auto&& s : inputs) benchmark::DoNotOptimize(set.match(s));
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(inputs.size()));
+    }
+
+    // every compiled pattern in turn
+    void glob_pattern_loop(benchmark::State& state) {
+        auto rules = make_rules(size_t(state.range(0)));
+        std::vector<glob_pattern> patterns(rules.begin(), rules.end());
+        auto inputs = make_inputs();
+        for(auto _ : state)
+            for(auto&& s : inputs) {
+                std::vector<size_t> res;
+                for(size_t ix = 0; ix < patterns.size(); ++ix)
+                    if(patterns[ix].match(s)) res.push_back(ix);
+                benchmark::DoNotOptimize(res);
+            }
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(inputs.size()));
+    }
+}
+
+BENCHMARK(glob_pattern_match);
+BENCHMARK(recursive_glob_match);
+BENCHMARK(glob_pattern_adversarial)->Arg(32)->Arg(64);
+BENCHMARK(recursive_glob_adversarial)->Arg(32)->Arg(64);
+BENCHMARK(glob_set_match)->Arg(32)->Arg(512);
+BENCHMARK(glob_pattern_loop)->Arg(32)->Arg(512);
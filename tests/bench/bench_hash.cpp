@@ -0,0 +1,64 @@
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "string_view.hpp"
+
+namespace {
+    using namespace essentials;
+
+    using fnv1a_hash = basic_string_view_hash<char, std::char_traits<char>, fnv1a_policy>;
+
+    template<class Hash>
+    void hash_throughput(benchmark::State& state) {
+        std::string key(size_t(state.range(0)), 'k');
+        Hash hasher;
+        for(auto _ : state) benchmark::DoNotOptimize(hasher(key));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(key.size()));
+    }
+
+    void hash_std_string(benchmark::State& state) {
+        std::string key(size_t(state.range(0)), 'k');
+        std::hash<std::string> hasher;
+        for(auto _ : state) benchmark::DoNotOptimize(hasher(key));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(key.size()));
+    }
+
+    void hash_u16string_view(benchmark::State& state) {
+        std::u16string key(size_t(state.range(0)) / 2, u'k');
+        std::hash<u16string_view> hasher;
+        for(auto _ : state) benchmark::DoNotOptimize(hasher(key));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(key.size() * 2));
+    }
+
+    /*
+     * Collision quality: low-entropy symbol-table keys bucketed into a power-of-two table.
+     * `excess` is the number of collisions above what an ideal random hash gives.
+     */
+    template<class Hash>
+    void hash_bucket_quality(benchmark::State& state) {
+        auto keys = size_t(state.range(0));
+        auto buckets = size_t(1) << 16;
+        std::vector<std::string> storage;
+        for(size_t i = 0; i < keys; ++i) storage.push_back("sym" + std::to_string(i * 64));
+        Hash hasher;
+        double excess = 0;
+        for(auto _ : state) {
+            std::vector<uint32_t> table(buckets);
+            size_t collisions = 0;
+            for(auto&& key : storage) collisions += table[hasher(key) & (buckets - 1)]++ != 0;
+            // expected collisions for uniform hashing: keys - buckets * (1 - (1 - 1/buckets)^keys)
+            double expected = double(keys) - double(buckets) * (1.0 - std::pow(1.0 - 1.0 / double(buckets), double(keys)));
+            excess = double(collisions) - expected;
+        }
+        state.counters["excess"] = excess;
+    }
+
+    BENCHMARK_TEMPLATE(hash_throughput, string_view_hash)->RangeMultiplier(4)->Range(4, 1 << 16);
+    BENCHMARK_TEMPLATE(hash_throughput, fnv1a_hash)->RangeMultiplier(4)->Range(4, 1 << 16);
+    BENCHMARK(hash_std_string)->RangeMultiplier(4)->Range(4, 1 << 16);
+    BENCHMARK(hash_u16string_view)->RangeMultiplier(4)->Range(4, 1 << 16);
+    BENCHMARK_TEMPLATE(hash_bucket_quality, string_view_hash)->Arg(1 << 15);
+    BENCHMARK_TEMPLATE(hash_bucket_quality, fnv1a_hash)->Arg(1 << 15);
+}
@@ -0,0 +1,61 @@
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "intern_pool.hpp"
+
+namespace {
+    using namespace essentials;
+
+    std::vector<std::string> make_tokens(size_t count) {
+        std::vector<std::string> res;
+        for(size_t i = 0; i < count; ++i) res.push_back("token_" + std::to_string(i * 2654435761u % 1000003));
+        return res;
+    }
+
+    void intern_pool_insert(benchmark::State& state) {
+        auto tokens = make_tokens(size_t(state.range(0)));
+        for(auto _ : state) {
+            intern_pool pool;
+            for(auto&& token : tokens) benchmark::DoNotOptimize(pool.intern(token));
+        }
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(tokens.size()));
+    }
+
+    void unordered_set_insert(benchmark::State& state) {
+        auto tokens = make_tokens(size_t(state.range(0)));
+        for(auto _ : state) {
+            std::unordered_set<std::string> pool;
+            for(auto&& token : tokens) benchmark::DoNotOptimize(pool.insert(token));
+        }
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(tokens.size()));
+    }
+
+    // the same key looked up in several tables: cached hash against rehashing every time
+    void lookup_hashed_string_view(benchmark::State& state) {
+        std::unordered_map<hashed_string_view, int> tables[4];
+        auto tokens = make_tokens(1000);
+        for(auto&& table : tables)
+            for(auto&& token : tokens) table[hashed_string_view(token)] = 1;
+        hashed_string_view key = string_view(tokens[500]);
+        for(auto _ : state)
+            for(auto&& table : tables) benchmark::DoNotOptimize(table.find(key));
+    }
+
+    void lookup_string_view(benchmark::State& state) {
+        std::unordered_map<string_view, int> tables[4];
+        auto tokens = make_tokens(1000);
+        for(auto&& table : tables)
+            for(auto&& token : tokens) table[token] = 1;
+        string_view key = tokens[500];
+        for(auto _ : state)
+            for(auto&& table : tables) benchmark::DoNotOptimize(table.find(key));
+    }
+
+    BENCHMARK(intern_pool_insert)->Arg(50000);
+    BENCHMARK(unordered_set_insert)->Arg(50000);
+    BENCHMARK(lookup_hashed_string_view);
+    BENCHMARK(lookup_string_view);
+}
@@ -0,0 +1,74 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include "mapped_file.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // a 64 MiB log written once per process
+    const std::string& log_path() {
+        static const std::string path = [] {
+            std::string res = "/tmp/string_view_bench_log";
+            std::ofstream out(res, std::ios::binary);
+            std::string line;
+            for(size_t i = 0, written = 0; written < (64u << 20); ++i) {
+                line = "ts=" + std::to_string(1700000000 + i) + " level=info path=/api/v1/items/" + std::to_string(i * 31) + "\n";
+                out << line;
+                written += line.size();
+            }
+            return res;
+        }();
+        return path;
+    }
+
+    void lines_mapped_file(benchmark::State& state) {
+        size_t bytes = 0;
+        for(auto _ : state) {
+            mapped_file mf(log_path(), map_advice::sequential);
+            size_t count = 0;
+            for(auto line : mf.lines()) count += !line.empty();
+            benchmark::DoNotOptimize(count);
+            bytes = mf.size();
+        }
+        state.SetBytesProcessed(int64_t(state.iterations() * bytes));
+    }
+
+    void lines_read_string(benchmark::State& state) {
+        size_t bytes = 0;
+        for(auto _ : state) {
+            std::ifstream in(log_path(), std::ios::binary);
+            std::stringstream buffer;
+            buffer << in.rdbuf();
+            auto content = buffer.str();
+            size_t count = 0;
+            for(auto line : lines(string_view(content))) count += !line.empty();
+            benchmark::DoNotOptimize(count);
+            bytes = content.size();
+        }
+        state.SetBytesProcessed(int64_t(state.iterations() * bytes));
+    }
+
+    void lines_getline(benchmark::State& state) {
+        size_t bytes = 0;
+        for(auto _ : state) {
+            std::ifstream in(log_path(), std::ios::binary);
+            std::string line;
+            size_t count = 0;
+            bytes = 0;
+            while(std::getline(in, line)) {
+                count += !line.empty();
+                bytes += line.size() + 1;
+            }
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetBytesProcessed(int64_t(state.iterations() * bytes));
+    }
+
+    BENCHMARK(lines_mapped_file)->Unit(benchmark::kMillisecond);
+    BENCHMARK(lines_read_string)->Unit(benchmark::kMillisecond);
+    BENCHMARK(lines_getline)->Unit(benchmark::kMillisecond);
+}
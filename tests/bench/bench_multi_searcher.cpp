@@ -0,0 +1,74 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "multi_searcher.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // a log-like text and a keyword list of which only a few occur
+    struct keyword_data {
+        std::string text;
+        std::vector<std::string> keywords;
+
+        explicit keyword_data(size_t count) {
+            std::mt19937 rng(42);
+            while(text.size() < (1u << 20)) {
+                text += "ts=" + std::to_string(rng() % 1000000) + " level=info path=/api/v1/items/";
+                text += std::to_string(rng() % 100000) + " status=200\n";
+            }
+            for(size_t i = 0; i < count; ++i) {
+                std::string keyword(6 + rng() % 10, 'a');
+                for(auto&& c : keyword) c = char('a' + rng() % 26);
+                keywords.push_back(keyword);
+            }
+            keywords[0] = "status=503";
+        }
+    };
+
+    void build_multi_searcher(benchmark::State& state) {
+        keyword_data data(size_t(state.range(0)));
+        for(auto _ : state) {
+            multi_searcher ms(data.keywords.begin(), data.keywords.end());
+            benchmark::DoNotOptimize(ms);
+        }
+    }
+
+    void scan_multi_searcher(benchmark::State& state) {
+        keyword_data data(size_t(state.range(0)));
+        multi_searcher ms(data.keywords.begin(), data.keywords.end());
+        for(auto _ : state) {
+            size_t hits = 0;
+            ms.for_each_match(data.text, [&hits](multi_searcher::match) { ++hits; });
+            benchmark::DoNotOptimize(hits);
+        }
+        state.SetBytesProcessed(int64_t(state.iterations() * data.text.size()));
+    }
+
+    void scan_separate_finds(benchmark::State& state) {
+        keyword_data data(size_t(state.range(0)));
+        for(auto _ : state) {
+            size_t hits = 0;
+            string_view text(data.text);
+            for(auto&& keyword : data.keywords)
+                for(auto at = text.find(keyword); at != string_view::npos; at = text.find(keyword, at + 1)) ++hits;
+            benchmark::DoNotOptimize(hits);
+        }
+        state.SetBytesProcessed(int64_t(state.iterations() * data.text.size()));
+    }
+
+    // a match right at the start of a large haystack: only the first block should be scanned
+    void find_first_early(benchmark::State& state) {
+        keyword_data data(size_t(state.range(0)));
+        auto text = "status=503 " + data.text;
+        multi_searcher ms(data.keywords.begin(), data.keywords.end());
+        for(auto _ : state) benchmark::DoNotOptimize(ms.find_first(text));
+    }
+
+    BENCHMARK(build_multi_searcher)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+    BENCHMARK(scan_multi_searcher)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+    BENCHMARK(find_first_early)->Arg(10)->Arg(100);
+    BENCHMARK(scan_separate_finds)->Arg(10)->Arg(100)->Arg(1000);
+}
@@ -0,0 +1,47 @@
+#include <string>
+#include <thread>
+
+#include "bench_common.hpp"
+#include "parallel.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // scaling from 1 to all hardware threads over the largest haystack of the sweeps
+    void thread_counts(benchmark::internal::Benchmark* b) {
+        auto hardware = std::max(1u, std::thread::hardware_concurrency());
+        for(unsigned threads = 1; threads < hardware; threads *= 2) b->Arg(threads);
+        b->Arg(hardware);
+    }
+
+    void parallel_count_threads(benchmark::State& state) {
+        auto needle = bench::needle(16, 64);
+        auto hay = bench::haystack(bench::max_size(), 64, needle);
+        thread_pool pool(unsigned(state.range(0)));
+        for(auto _ : state) benchmark::DoNotOptimize(parallel_count(string_view(hay), string_view(needle), pool));
+        bench::set_bytes(state, hay.size());
+    }
+
+    void parallel_find_char_threads(benchmark::State& state) {
+        auto hay = bench::haystack(bench::max_size(), 64, "#");
+        thread_pool pool(unsigned(state.range(0)));
+        for(auto _ : state) benchmark::DoNotOptimize(parallel_find(string_view(hay), '#', pool));
+        bench::set_bytes(state, hay.size());
+    }
+
+    void sequential_count(benchmark::State& state) {
+        auto needle = bench::needle(16, 64);
+        auto hay = bench::haystack(bench::max_size(), 64, needle);
+        string_view v = hay;
+        for(auto _ : state) {
+            size_t count = 0;
+            for(auto pos = v.find(needle); pos != string_view::npos; pos = v.find(needle, pos + 1)) ++count;
+            benchmark::DoNotOptimize(count);
+        }
+        bench::set_bytes(state, hay.size());
+    }
+
+    BENCHMARK(sequential_count)->Unit(benchmark::kMillisecond);
+    BENCHMARK(parallel_count_threads)->Apply(thread_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
+    BENCHMARK(parallel_find_char_threads)->Apply(thread_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
+}
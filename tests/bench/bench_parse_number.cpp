@@ -0,0 +1,70 @@
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "parse_number.hpp"
+#include "split.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // one numeric CSV column, a value per line
+    std::string make_column(size_t count, bool floats) {
+        std::mt19937_64 rng(42);
+        std::string res;
+        char buffer[32];
+        for(size_t i = 0; i < count; ++i) {
+            if(floats) snprintf(buffer, sizeof(buffer), "%.17g", double(rng() % 100000000) / 997.0);
+            else snprintf(buffer, sizeof(buffer), "%lld", (long long)(rng() >> (rng() % 64)));
+            res += buffer;
+            res += '\n';
+        }
+        return res;
+    }
+
+    template<class F>
+    void run_column(benchmark::State& state, bool floats, F&& parse) {
+        auto column = make_column(size_t(state.range(0)), floats);
+        auto range = lines(string_view(column));
+        std::vector<string_view> lines(range.begin(), range.end());
+        for(auto _ : state)
+            for(auto&& line : lines) benchmark::DoNotOptimize(parse(line));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(column.size()));
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(lines.size()));
+    }
+
+    void parse_int_view(benchmark::State& state) {
+        run_column(state, false, [](string_view v) { return parse_int<int64_t>(v).value; });
+    }
+
+    // the C++14 alternative: copy for the terminator, then strtoll
+    void parse_int_strtoll(benchmark::State& state) {
+        run_column(state, false, [](string_view v) { return std::strtoll(std::string(v).c_str(), nullptr, 10); });
+    }
+
+    void parse_float_view(benchmark::State& state) {
+        run_column(state, true, [](string_view v) { return parse_float<double>(v).value; });
+    }
+
+    void parse_float_strtod(benchmark::State& state) {
+        run_column(state, true, [](string_view v) { return std::strtod(std::string(v).c_str(), nullptr); });
+    }
+
+    // a whole column in one call, newline-delimited
+    void parse_delimited_column(benchmark::State& state) {
+        auto column = make_column(size_t(state.range(0)), true);
+        std::vector<double> values(size_t(state.range(0)));
+        for(auto _ : state) benchmark::DoNotOptimize(parse_delimited<double>(column, '\n', values.data()));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(column.size()));
+        state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+    }
+
+    BENCHMARK(parse_int_view)->Arg(10000);
+    BENCHMARK(parse_int_strtoll)->Arg(10000);
+    BENCHMARK(parse_float_view)->Arg(10000);
+    BENCHMARK(parse_float_strtod)->Arg(10000);
+    BENCHMARK(parse_delimited_column)->Arg(10000);
+}
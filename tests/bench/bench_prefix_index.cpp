@@ -0,0 +1,72 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "prefix_index.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // /svcN/vM/resourceK route prefixes, the way a router configuration grows
+    std::vector<std::pair<std::string, size_t>> make_routes(size_t count) {
+        std::vector<std::pair<std::string, size_t>> res;
+        for(size_t i = 0; res.size() < count; ++i) {
+            auto service = "/svc" + std::to_string(i % 97);
+            res.emplace_back(service + "/v" + std::to_string(i % 3) + "/resource" + std::to_string(i), res.size());
+            if(i % 5 == 0 && res.size() < count) res.emplace_back(service + "/v" + std::to_string(i % 3), res.size());
+        }
+        return res;
+    }
+
+    std::vector<std::string> make_paths(const std::vector<std::pair<std::string, size_t>>& routes) {
+        std::vector<std::string> res;
+        for(size_t i = 0; i < 256; ++i) {
+            auto&& route = routes[i * 7919 % routes.size()].first;
+            res.push_back(route + ((i % 4 == 0)? "" : "/items/" + std::to_string(i)));
+            if(i % 8 == 0) res.push_back("/unknown" + route);
+        }
+        return res;
+    }
+
+    void prefix_index_longest(benchmark::State& state) {
+        auto routes = make_routes(size_t(state.range(0)));
+        auto paths = make_paths(routes);
+        prefix_index<size_t> index(routes.begin(), routes.end());
+        for(auto _ : state)
+            for(auto&& p : paths) benchmark::DoNotOptimize(index.longest_prefix(p));
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(paths.size()));
+    }
+
+    // what the router does today
+    void linear_scan_longest(benchmark::State& state) {
+        auto routes = make_routes(size_t(state.range(0)));
+        auto paths = make_paths(routes);
+        std::vector<string_view> prefixes;
+        for(auto&& r : routes) prefixes.push_back(r.first);
+        for(auto _ : state)
+            for(auto&& p : paths) {
+                string_view path = p;
+                const string_view* best = nullptr;
+                for(auto&& prefix : prefixes)
+                    if(prefix.size() <= path.size() && path.compare(0, prefix.size(), prefix) == 0
+                        && (!best || best->size() < prefix.size())) best = &prefix;
+                benchmark::DoNotOptimize(best);
+            }
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(paths.size()));
+    }
+
+    // a configuration reload
+    void prefix_index_build(benchmark::State& state) {
+        auto routes = make_routes(size_t(state.range(0)));
+        for(auto _ : state) {
+            prefix_index<size_t> index(routes.begin(), routes.end());
+            benchmark::DoNotOptimize(index.size());
+        }
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(routes.size()));
+    }
+
+    BENCHMARK(prefix_index_longest)->Range(16, 16384);
+    BENCHMARK(linear_scan_longest)->Range(16, 16384);
+    BENCHMARK(prefix_index_build)->Range(16, 16384);
+}
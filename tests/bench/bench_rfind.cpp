@@ -0,0 +1,54 @@
+#include <cstring>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include "string_view.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // a ring-buffer-like tail: the only delimiter is at the very start
+    std::string make_buffer(size_t size) {
+        std::string res(size, 'x');
+        res.replace(0, 6, "\nlast:");
+        return res;
+    }
+
+    void rfind_char_string_view(benchmark::State& state) {
+        auto buffer = make_buffer(size_t(state.range(0)));
+        string_view vb = buffer;
+        for(auto _ : state) benchmark::DoNotOptimize(vb.rfind('\n'));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(buffer.size()));
+    }
+
+    void rfind_char_memrchr(benchmark::State& state) {
+        auto buffer = make_buffer(size_t(state.range(0)));
+        for(auto _ : state) benchmark::DoNotOptimize(memrchr(buffer.data(), '\n', buffer.size()));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(buffer.size()));
+    }
+
+    void rfind_char_std_string(benchmark::State& state) {
+        auto buffer = make_buffer(size_t(state.range(0)));
+        for(auto _ : state) benchmark::DoNotOptimize(buffer.rfind('\n'));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(buffer.size()));
+    }
+
+    void rfind_string_view(benchmark::State& state) {
+        auto buffer = make_buffer(size_t(state.range(0)));
+        string_view vb = buffer;
+        for(auto _ : state) benchmark::DoNotOptimize(vb.rfind("last:"));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(buffer.size()));
+    }
+
+    void rfind_std_string(benchmark::State& state) {
+        auto buffer = make_buffer(size_t(state.range(0)));
+        for(auto _ : state) benchmark::DoNotOptimize(buffer.rfind("last:"));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(buffer.size()));
+    }
+
+    BENCHMARK(rfind_char_string_view)->Range(64, 1 << 20);
+    BENCHMARK(rfind_char_memrchr)->Range(64, 1 << 20);
+    BENCHMARK(rfind_char_std_string)->Range(64, 1 << 20);
+    BENCHMARK(rfind_string_view)->Range(64, 1 << 20);
+    BENCHMARK(rfind_std_string)->Range(64, 1 << 20);
+}
@@ -0,0 +1,53 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "searcher.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // a filter engine: a set of needles matched against many short records
+    struct filter_data {
+        std::vector<std::string> records;
+        std::vector<std::string> needles;
+
+        explicit filter_data(size_t needle_size) {
+            for(int i = 0; i < 1000; ++i)
+                records.push_back("ts=" + std::to_string(1700000000 + i) + " level=info user=u" + std::to_string(i % 97) +
+                                  " path=/api/v1/items/" + std::to_string(i * 31) + " status=200 " + std::string(needle_size, 'x'));
+            for(int i = 0; i < 300; ++i) {
+                auto needle = "user=u" + std::to_string(i) + " path=/api/v1/items/";
+                needle.resize(needle_size, 'y');
+                needles.push_back(needle);
+            }
+        }
+    };
+
+    void filter_find(benchmark::State& state) {
+        filter_data data(size_t(state.range(0)));
+        for(auto _ : state) {
+            size_t hits = 0;
+            for(auto&& record : data.records)
+                for(auto&& needle : data.needles)
+                    hits += string_view(record).find(needle) != string_view::npos;
+            benchmark::DoNotOptimize(hits);
+        }
+    }
+
+    void filter_searcher(benchmark::State& state) {
+        filter_data data(size_t(state.range(0)));
+        std::vector<searcher> searchers;
+        for(auto&& needle : data.needles) searchers.emplace_back(needle);
+        for(auto _ : state) {
+            size_t hits = 0;
+            for(auto&& record : data.records)
+                for(auto&& s : searchers)
+                    hits += string_view(record).find(s) != string_view::npos;
+            benchmark::DoNotOptimize(hits);
+        }
+    }
+
+    BENCHMARK(filter_find)->Arg(12)->Arg(100)->Arg(400);
+    BENCHMARK(filter_searcher)->Arg(12)->Arg(100)->Arg(400);
+}
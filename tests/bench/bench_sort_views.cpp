@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "sort_views.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // URL-like keys: long shared prefixes, then a random tail, stored apart from each other
+    struct key_data {
+        std::vector<std::string> storage;
+        std::vector<string_view> views;
+
+        explicit key_data(size_t count) {
+            static const char* hosts[] = { "https://example.com/api/v1/", "https://example.org/static/", "http://cdn.example.net/" };
+            std::mt19937 rng(17);
+            for(size_t ix = 0; ix < count; ++ix)
+                storage.push_back(std::string(hosts[rng() % 3]) + "items/" + std::to_string(rng() % (count * 4)));
+            std::shuffle(storage.begin(), storage.end(), rng);
+            views.assign(storage.begin(), storage.end());
+        }
+    };
+
+    void sort_std_sort(benchmark::State& state) {
+        key_data data(size_t(state.range(0)));
+        for(auto _ : state) {
+            auto views = data.views;
+            std::sort(views.begin(), views.end());
+            benchmark::DoNotOptimize(views.data());
+        }
+        state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+    }
+
+    void sort_radix(benchmark::State& state) {
+        key_data data(size_t(state.range(0)));
+        for(auto _ : state) {
+            auto views = data.views;
+            sort_views(views.begin(), views.end(), unsigned(state.range(1)));
+            benchmark::DoNotOptimize(views.data());
+        }
+        state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+    }
+
+    void sort_radix_stable(benchmark::State& state) {
+        key_data data(size_t(state.range(0)));
+        for(auto _ : state) {
+            auto views = data.views;
+            stable_sort_views(views.begin(), views.end(), 1);
+            benchmark::DoNotOptimize(views.data());
+        }
+        state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+    }
+
+    BENCHMARK(sort_std_sort)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 23)->Unit(benchmark::kMillisecond);
+    BENCHMARK(sort_radix)->ArgsProduct({ { 1 << 16, 1 << 20, 1 << 23 }, { 1, 2, 4, 8 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+    BENCHMARK(sort_radix_stable)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 23)->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,70 @@
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include "split.hpp"
+
+namespace {
+    using namespace essentials;
+
+    std::string make_csv_line(size_t size) {
+        std::string res;
+        for(int i = 0; res.size() < size; ++i) res += std::to_string(i * 7919) + ",";
+        res.resize(size);
+        return res;
+    }
+
+    void split_char(benchmark::State& state) {
+        auto line = make_csv_line(size_t(state.range(0)));
+        for(auto _ : state) {
+            size_t total = 0;
+            for(auto field : split(string_view(line), ',')) total += field.size();
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(line.size()));
+    }
+
+    void split_char_set(benchmark::State& state) {
+        auto line = make_csv_line(size_t(state.range(0)));
+        char_set delims = ",;\t";
+        for(auto _ : state) {
+            size_t total = 0;
+            for(auto field : split(string_view(line), delims)) total += field.size();
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(line.size()));
+    }
+
+    void split_find_loop(benchmark::State& state) {
+        auto line = make_csv_line(size_t(state.range(0)));
+        for(auto _ : state) {
+            size_t total = 0;
+            string_view rest = line;
+            while(true) {
+                auto pos = rest.find(',');
+                if(pos == string_view::npos) { total += rest.size(); break; }
+                total += rest.substr(0, pos).size();
+                rest.remove_prefix(pos + 1);
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(line.size()));
+    }
+
+    void split_getline(benchmark::State& state) {
+        auto line = make_csv_line(size_t(state.range(0)));
+        for(auto _ : state) {
+            size_t total = 0;
+            std::istringstream is(line);
+            std::string field;
+            while(std::getline(is, field, ',')) total += field.size();
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(line.size()));
+    }
+
+    BENCHMARK(split_char)->Range(64, 1 << 20);
+    BENCHMARK(split_char_set)->Range(64, 1 << 20);
+    BENCHMARK(split_find_loop)->Range(64, 1 << 20);
+    BENCHMARK(split_getline)->Range(64, 1 << 20);
+}
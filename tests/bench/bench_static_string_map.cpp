@@ -0,0 +1,64 @@
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "static_string_map.hpp"
+
+namespace {
+    using namespace essentials;
+
+    constexpr auto headers = make_static_string_map<int>({
+        { "accept"_sv, 0 }, { "accept-encoding"_sv, 1 }, { "accept-language"_sv, 2 }, { "authorization"_sv, 3 },
+        { "cache-control"_sv, 4 }, { "connection"_sv, 5 }, { "content-length"_sv, 6 }, { "content-type"_sv, 7 },
+        { "cookie"_sv, 8 }, { "date"_sv, 9 }, { "host"_sv, 10 }, { "if-modified-since"_sv, 11 },
+        { "if-none-match"_sv, 12 }, { "origin"_sv, 13 }, { "referer"_sv, 14 }, { "user-agent"_sv, 15 },
+    });
+
+    // every key plus as many misses, as they come from real requests
+    std::vector<std::string> make_queries() {
+        std::vector<std::string> res;
+        for(size_t ix = 0; ix < headers.size(); ++ix) {
+            res.push_back(std::string(headers.key(ix)));
+            res.push_back("x-custom-" + std::to_string(ix));
+        }
+        return res;
+    }
+
+    void static_string_map_lookup(benchmark::State& state) {
+        auto queries = make_queries();
+        for(auto _ : state)
+            for(auto&& q : queries) benchmark::DoNotOptimize(headers.find(q));
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(queries.size()));
+    }
+
+    void unordered_map_lookup(benchmark::State& state) {
+        std::unordered_map<string_view, int> map;
+        for(size_t ix = 0; ix < headers.size(); ++ix) map[headers.key(ix)] = headers.value(ix);
+        auto queries = make_queries();
+        for(auto _ : state)
+            for(auto&& q : queries) benchmark::DoNotOptimize(map.find(q));
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(queries.size()));
+    }
+
+    // the if chain static_string_map replaces
+    void if_chain_lookup(benchmark::State& state) {
+        auto queries = make_queries();
+        for(auto _ : state)
+            for(auto&& q : queries) {
+                string_view v = q;
+                int found = -1;
+                for(size_t ix = 0; ix < headers.size(); ++ix)
+                    if(v == headers.key(ix)) {
+                        found = int(ix);
+                        break;
+                    }
+                benchmark::DoNotOptimize(found);
+            }
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(queries.size()));
+    }
+
+    BENCHMARK(static_string_map_lookup);
+    BENCHMARK(unordered_map_lookup);
+    BENCHMARK(if_chain_lookup);
+}
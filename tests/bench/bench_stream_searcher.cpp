@@ -0,0 +1,51 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "bench_common.hpp"
+#include "stream_searcher.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // 1 MiB of text with a multipart boundary every 64 KiB, cut into packets of `range(0)` bytes
+    struct stream_data {
+        std::string needle = "\r\n--boundary-7f3a9c";
+        std::string body;
+        std::vector<string_view> packets;
+
+        explicit stream_data(size_t packet) {
+            body = bench::text(1 << 20, 64);
+            for(size_t pos = 65536 - 7; pos + needle.size() < body.size(); pos += 65536) body.replace(pos, needle.size(), needle);
+            for(size_t pos = 0; pos < body.size(); pos += packet) packets.push_back(string_view(body).substr(pos, packet));
+        }
+    };
+
+    void stream_searcher_chunks(benchmark::State& state) {
+        stream_data data(size_t(state.range(0)));
+        for(auto _ : state) {
+            stream_searcher s(data.needle);
+            size_t hits = 0;
+            for(auto&& p : data.packets) s.feed(p, [&hits](size_t) { ++hits; });
+            benchmark::DoNotOptimize(hits);
+        }
+        bench::set_bytes(state, data.body.size());
+    }
+
+    // what the proxy does today: gather the packets, then search
+    void concatenate_find(benchmark::State& state) {
+        stream_data data(size_t(state.range(0)));
+        for(auto _ : state) {
+            std::string joined;
+            for(auto&& p : data.packets) joined.append(p.data(), p.size());
+            size_t hits = 0;
+            string_view v = joined;
+            for(auto pos = v.find(data.needle); pos != string_view::npos; pos = v.find(data.needle, pos + 1)) ++hits;
+            benchmark::DoNotOptimize(hits);
+        }
+        bench::set_bytes(state, data.body.size());
+    }
+
+    BENCHMARK(stream_searcher_chunks)->Arg(64)->Arg(1500)->Arg(16384);
+    BENCHMARK(concatenate_find)->Arg(64)->Arg(1500)->Arg(16384);
+}
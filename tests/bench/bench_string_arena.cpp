@@ -0,0 +1,45 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "string_arena.hpp"
+
+namespace {
+    using namespace essentials;
+
+    std::vector<std::string> make_fields(size_t count) {
+        std::vector<std::string> res;
+        for(size_t i = 0; i < count; ++i) res.push_back("field_value_" + std::to_string(i * 2654435761u % 1000003));
+        return res;
+    }
+
+    // one request's worth of owned copies, then drop them all
+    void arena_store(benchmark::State& state) {
+        auto fields = make_fields(size_t(state.range(0)));
+        string_arena arena;
+        std::vector<string_view> owned;
+        owned.reserve(fields.size());
+        for(auto _ : state) {
+            string_arena::scope request(arena);
+            owned.clear();
+            for(auto&& f : fields) owned.push_back(arena.store(f));
+            benchmark::DoNotOptimize(owned.data());
+        }
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(fields.size()));
+    }
+
+    void string_copy(benchmark::State& state) {
+        auto fields = make_fields(size_t(state.range(0)));
+        std::vector<std::string> owned;
+        owned.reserve(fields.size());
+        for(auto _ : state) {
+            owned.clear();
+            for(auto&& f : fields) owned.emplace_back(f);
+            benchmark::DoNotOptimize(owned.data());
+        }
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(fields.size()));
+    }
+
+    BENCHMARK(arena_store)->Arg(1000)->Arg(100000);
+    BENCHMARK(string_copy)->Arg(1000)->Arg(100000);
+}
@@ -0,0 +1,260 @@
+#include <cstring>
+#include <functional>
+#include <string>
+#if __cplusplus >= 201703L
+# include <string_view>
+#endif
+
+#include "bench_common.hpp"
+#include "string_view.hpp"
+
+/*
+ * The sweep over every search and comparison member of basic_string_view,
+ * each next to std::string, std::string_view (C++17 builds) and the C library.
+ * Every haystack holds exactly one match, planted where the scan has to cover all of it.
+ * Arguments are haystack size, then needle size and alphabet size where they apply.
+ */
+namespace {
+    using namespace essentials;
+
+    const size_t plain_alphabet = 64;
+
+    /* find(char): the '#' sentinel is the last byte */
+
+    void find_char_view(benchmark::State& state) {
+        auto hay = bench::haystack(size_t(state.range(0)), plain_alphabet, "#");
+        string_view v = hay;
+        for(auto _ : state) benchmark::DoNotOptimize(v.find('#'));
+        bench::set_bytes(state, hay.size());
+    }
+    void find_char_std_string(benchmark::State& state) {
+        auto hay = bench::haystack(size_t(state.range(0)), plain_alphabet, "#");
+        for(auto _ : state) benchmark::DoNotOptimize(hay.find('#'));
+        bench::set_bytes(state, hay.size());
+    }
+    void find_char_memchr(benchmark::State& state) {
+        auto hay = bench::haystack(size_t(state.range(0)), plain_alphabet, "#");
+        for(auto _ : state) benchmark::DoNotOptimize(std::memchr(hay.data(), '#', hay.size()));
+        bench::set_bytes(state, hay.size());
+    }
+
+    /* find(needle) */
+
+    struct search_data {
+        std::string needle;
+        std::string hay;
+
+        explicit search_data(const benchmark::State& state):
+            needle(bench::needle(size_t(state.range(1)), size_t(state.range(2)))),
+            hay(bench::haystack(size_t(state.range(0)), size_t(state.range(2)), needle)) {}
+    };
+
+    void find_view(benchmark::State& state) {
+        search_data data(state);
+        string_view v = data.hay;
+        for(auto _ : state) benchmark::DoNotOptimize(v.find(data.needle));
+        bench::set_bytes(state, data.hay.size());
+    }
+    void find_std_string(benchmark::State& state) {
+        search_data data(state);
+        for(auto _ : state) benchmark::DoNotOptimize(data.hay.find(data.needle));
+        bench::set_bytes(state, data.hay.size());
+    }
+    void find_memmem(benchmark::State& state) {
+        search_data data(state);
+        for(auto _ : state)
+            benchmark::DoNotOptimize(memmem(data.hay.data(), data.hay.size(), data.needle.data(), data.needle.size()));
+        bench::set_bytes(state, data.hay.size());
+    }
+    void find_strstr(benchmark::State& state) {
+        search_data data(state);
+        for(auto _ : state) benchmark::DoNotOptimize(std::strstr(data.hay.c_str(), data.needle.c_str()));
+        bench::set_bytes(state, data.hay.size());
+    }
+
+    /* rfind: the match is planted at the very start */
+
+    struct reverse_data {
+        std::string needle;
+        std::string hay;
+
+        explicit reverse_data(const benchmark::State& state, size_t needle_size, size_t alphabet):
+            needle(bench::needle(needle_size, alphabet)),
+            hay(bench::text(size_t(state.range(0)), alphabet)) {
+            if(needle.size() <= hay.size()) hay.replace(0, needle.size(), needle);
+        }
+    };
+
+    void rfind_char_view(benchmark::State& state) {
+        reverse_data data(state, 1, plain_alphabet);
+        string_view v = data.hay;
+        for(auto _ : state) benchmark::DoNotOptimize(v.rfind('#'));
+        bench::set_bytes(state, data.hay.size());
+    }
+    void rfind_char_std_string(benchmark::State& state) {
+        reverse_data data(state, 1, plain_alphabet);
+        for(auto _ : state) benchmark::DoNotOptimize(data.hay.rfind('#'));
+        bench::set_bytes(state, data.hay.size());
+    }
+    void rfind_char_memrchr(benchmark::State& state) {
+        reverse_data data(state, 1, plain_alphabet);
+        for(auto _ : state) benchmark::DoNotOptimize(memrchr(data.hay.data(), '#', data.hay.size()));
+        bench::set_bytes(state, data.hay.size());
+    }
+    void rfind_view(benchmark::State& state) {
+        reverse_data data(state, size_t(state.range(1)), size_t(state.range(2)));
+        string_view v = data.hay;
+        for(auto _ : state) benchmark::DoNotOptimize(v.rfind(data.needle));
+        bench::set_bytes(state, data.hay.size());
+    }
+    void rfind_std_string(benchmark::State& state) {
+        reverse_data data(state, size_t(state.range(1)), size_t(state.range(2)));
+        for(auto _ : state) benchmark::DoNotOptimize(data.hay.rfind(data.needle));
+        bench::set_bytes(state, data.hay.size());
+    }
+
+    /* find_first_of: none of the set occurs before the last byte */
+
+    const char set_chars[] = "#!$%&";
+
+    void find_first_of_view(benchmark::State& state) {
+        auto hay = bench::haystack(size_t(state.range(0)), plain_alphabet, "#");
+        string_view v = hay;
+        for(auto _ : state) benchmark::DoNotOptimize(v.find_first_of(set_chars));
+        bench::set_bytes(state, hay.size());
+    }
+    void find_first_of_char_set(benchmark::State& state) {
+        auto hay = bench::haystack(size_t(state.range(0)), plain_alphabet, "#");
+        string_view v = hay;
+        char_set set = set_chars;
+        for(auto _ : state) benchmark::DoNotOptimize(v.find_first_of(set));
+        bench::set_bytes(state, hay.size());
+    }
+    void find_first_of_std_string(benchmark::State& state) {
+        auto hay = bench::haystack(size_t(state.range(0)), plain_alphabet, "#");
+        for(auto _ : state) benchmark::DoNotOptimize(hay.find_first_of(set_chars));
+        bench::set_bytes(state, hay.size());
+    }
+    void find_first_of_strpbrk(benchmark::State& state) {
+        auto hay = bench::haystack(size_t(state.range(0)), plain_alphabet, "#");
+        for(auto _ : state) benchmark::DoNotOptimize(std::strpbrk(hay.c_str(), set_chars));
+        bench::set_bytes(state, hay.size());
+    }
+
+    /* compare: equal up to the last byte */
+
+    struct compare_data {
+        std::string lhv;
+        std::string rhv;
+
+        explicit compare_data(const benchmark::State& state):
+            lhv(bench::text(size_t(state.range(0)), plain_alphabet)), rhv(lhv) {
+            rhv.back() = '#';
+        }
+    };
+
+    void compare_view(benchmark::State& state) {
+        compare_data data(state);
+        string_view lhv = data.lhv, rhv = data.rhv;
+        for(auto _ : state) benchmark::DoNotOptimize(lhv.compare(rhv));
+        bench::set_bytes(state, data.lhv.size());
+    }
+    void compare_std_string(benchmark::State& state) {
+        compare_data data(state);
+        for(auto _ : state) benchmark::DoNotOptimize(data.lhv.compare(data.rhv));
+        bench::set_bytes(state, data.lhv.size());
+    }
+    void compare_memcmp(benchmark::State& state) {
+        compare_data data(state);
+        for(auto _ : state) benchmark::DoNotOptimize(std::memcmp(data.lhv.data(), data.rhv.data(), data.lhv.size()));
+        bench::set_bytes(state, data.lhv.size());
+    }
+
+    /* hashing */
+
+    void hash_view(benchmark::State& state) {
+        auto key = bench::text(size_t(state.range(0)), plain_alphabet);
+        std::hash<string_view> hasher;
+        for(auto _ : state) benchmark::DoNotOptimize(hasher(key));
+        bench::set_bytes(state, key.size());
+    }
+    void hash_std_string(benchmark::State& state) {
+        auto key = bench::text(size_t(state.range(0)), plain_alphabet);
+        std::hash<std::string> hasher;
+        for(auto _ : state) benchmark::DoNotOptimize(hasher(key));
+        bench::set_bytes(state, key.size());
+    }
+
+#if __cplusplus >= 201703L
+    void find_char_std_string_view(benchmark::State& state) {
+        auto hay = bench::haystack(size_t(state.range(0)), plain_alphabet, "#");
+        std::string_view v = hay;
+        for(auto _ : state) benchmark::DoNotOptimize(v.find('#'));
+        bench::set_bytes(state, hay.size());
+    }
+    void find_std_string_view(benchmark::State& state) {
+        search_data data(state);
+        std::string_view v = data.hay;
+        for(auto _ : state) benchmark::DoNotOptimize(v.find(data.needle));
+        bench::set_bytes(state, data.hay.size());
+    }
+    void rfind_std_string_view(benchmark::State& state) {
+        reverse_data data(state, size_t(state.range(1)), size_t(state.range(2)));
+        std::string_view v = data.hay;
+        for(auto _ : state) benchmark::DoNotOptimize(v.rfind(data.needle));
+        bench::set_bytes(state, data.hay.size());
+    }
+    void find_first_of_std_string_view(benchmark::State& state) {
+        auto hay = bench::haystack(size_t(state.range(0)), plain_alphabet, "#");
+        std::string_view v = hay;
+        for(auto _ : state) benchmark::DoNotOptimize(v.find_first_of(set_chars));
+        bench::set_bytes(state, hay.size());
+    }
+    void compare_std_string_view(benchmark::State& state) {
+        compare_data data(state);
+        std::string_view lhv = data.lhv, rhv = data.rhv;
+        for(auto _ : state) benchmark::DoNotOptimize(lhv.compare(rhv));
+        bench::set_bytes(state, data.lhv.size());
+    }
+    void hash_std_string_view(benchmark::State& state) {
+        auto key = bench::text(size_t(state.range(0)), plain_alphabet);
+        std::hash<std::string_view> hasher;
+        for(auto _ : state) benchmark::DoNotOptimize(hasher(key));
+        bench::set_bytes(state, key.size());
+    }
+
+    BENCHMARK(find_char_std_string_view)->Apply(bench::sizes);
+    BENCHMARK(find_std_string_view)->Apply(bench::needle_sweep);
+    BENCHMARK(rfind_std_string_view)->Apply(bench::needle_sweep);
+    BENCHMARK(find_first_of_std_string_view)->Apply(bench::sizes);
+    BENCHMARK(compare_std_string_view)->Apply(bench::sizes);
+    BENCHMARK(hash_std_string_view)->Apply(bench::sizes);
+#endif
+
+    BENCHMARK(find_char_view)->Apply(bench::sizes);
+    BENCHMARK(find_char_std_string)->Apply(bench::sizes);
+    BENCHMARK(find_char_memchr)->Apply(bench::sizes);
+
+    BENCHMARK(find_view)->Apply(bench::needle_sweep);
+    BENCHMARK(find_std_string)->Apply(bench::needle_sweep);
+    BENCHMARK(find_memmem)->Apply(bench::needle_sweep);
+    BENCHMARK(find_strstr)->Apply(bench::needle_sweep);
+
+    BENCHMARK(rfind_char_view)->Apply(bench::sizes);
+    BENCHMARK(rfind_char_std_string)->Apply(bench::sizes);
+    BENCHMARK(rfind_char_memrchr)->Apply(bench::sizes);
+    BENCHMARK(rfind_view)->Apply(bench::needle_sweep);
+    BENCHMARK(rfind_std_string)->Apply(bench::needle_sweep);
+
+    BENCHMARK(find_first_of_view)->Apply(bench::sizes);
+    BENCHMARK(find_first_of_char_set)->Apply(bench::sizes);
+    BENCHMARK(find_first_of_std_string)->Apply(bench::sizes);
+    BENCHMARK(find_first_of_strpbrk)->Apply(bench::sizes);
+
+    BENCHMARK(compare_view)->Apply(bench::sizes);
+    BENCHMARK(compare_std_string)->Apply(bench::sizes);
+    BENCHMARK(compare_memcmp)->Apply(bench::sizes);
+
+    BENCHMARK(hash_view)->Apply(bench::sizes);
+    BENCHMARK(hash_std_string)->Apply(bench::sizes);
+}
@@ -0,0 +1,91 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "utf8.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // 1 MiB of text, `ascii_percent` of the code points ASCII and the rest spread over 2, 3 and 4 bytes
+    const std::string& text(int ascii_percent) {
+        static std::string cache[101];
+        auto&& res = cache[ascii_percent];
+        if(!res.empty()) return res;
+        std::mt19937 rng{ unsigned(ascii_percent) };
+        char buffer[4];
+        while(res.size() < (1u << 20)) {
+            char32_t cp;
+            if(int(rng() % 100) < ascii_percent) cp = 'a' + rng() % 26;
+            else switch(rng() % 3) {
+                case 0: cp = 0x430 + rng() % 32; break;
+                case 1: cp = 0x4E00 + rng() % 0x1000; break;
+                default: cp = 0x1F600 + rng() % 64; break;
+            }
+            res.append(buffer, detail::utf8_encode_one(cp, buffer));
+        }
+        return res;
+    }
+
+    void utf8_validate_simd(benchmark::State& state) {
+        auto&& s = text(int(state.range(0)));
+        for(auto _ : state) benchmark::DoNotOptimize(utf8_validate(s));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(s.size()));
+    }
+
+    // the code-point-at-a-time loop the SIMD path replaces
+    void utf8_validate_scalar(benchmark::State& state) {
+        auto&& s = text(int(state.range(0)));
+        auto p = reinterpret_cast<const unsigned char*>(s.data());
+        for(auto _ : state) {
+            size_t ix = 0;
+            char32_t cp;
+            while(ix < s.size()) {
+                auto length = detail::utf8_decode_one(p + ix, p + s.size(), cp);
+                if(length == 0) break;
+                ix += length;
+            }
+            benchmark::DoNotOptimize(ix);
+        }
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(s.size()));
+    }
+
+    void utf8_length_simd(benchmark::State& state) {
+        auto&& s = text(int(state.range(0)));
+        for(auto _ : state) benchmark::DoNotOptimize(utf8_length(s));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(s.size()));
+    }
+
+    void utf8_length_iterator(benchmark::State& state) {
+        auto&& s = text(int(state.range(0)));
+        for(auto _ : state) {
+            auto range = code_points(s);
+            benchmark::DoNotOptimize(std::distance(range.begin(), range.end()));
+        }
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(s.size()));
+    }
+
+    void utf8_to_utf16_transcode(benchmark::State& state) {
+        auto&& s = text(int(state.range(0)));
+        std::vector<char16_t> out(s.size());
+        for(auto _ : state) benchmark::DoNotOptimize(utf8_to_utf16(s, out.data()));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(s.size()));
+    }
+
+    void utf16_to_utf8_transcode(benchmark::State& state) {
+        auto&& s = text(int(state.range(0)));
+        std::vector<char16_t> utf16(s.size());
+        auto size = utf8_to_utf16(s, utf16.data()).written;
+        std::string out(s.size(), '\0');
+        for(auto _ : state) benchmark::DoNotOptimize(utf16_to_utf8(u16string_view(utf16.data(), size), &out[0]));
+        state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(s.size()));
+    }
+
+    BENCHMARK(utf8_validate_simd)->Arg(100)->Arg(90)->Arg(0);
+    BENCHMARK(utf8_validate_scalar)->Arg(100)->Arg(90)->Arg(0);
+    BENCHMARK(utf8_length_simd)->Arg(90);
+    BENCHMARK(utf8_length_iterator)->Arg(90);
+    BENCHMARK(utf8_to_utf16_transcode)->Arg(100)->Arg(90)->Arg(0);
+    BENCHMARK(utf16_to_utf8_transcode)->Arg(100)->Arg(90)->Arg(0);
+}
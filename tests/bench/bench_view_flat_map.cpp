@@ -0,0 +1,97 @@
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "view_flat_map.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // identifiers of 4 to 35 bytes, about half of them inline
+    std::vector<std::string> make_keys(size_t count, size_t salt = 0) {
+        std::vector<std::string> res;
+        for(size_t i = 0; i < count; ++i) {
+            auto id = std::to_string((i + salt) * 2654435761u % 1000003);
+            res.push_back(std::string(i % 32, '_') + "id" + id);
+        }
+        return res;
+    }
+
+    // counts the bytes unordered_map gets from its allocator
+    template<class T>
+    struct counting_allocator {
+        using value_type = T;
+        std::shared_ptr<size_t> bytes;
+
+        counting_allocator(): bytes(std::make_shared<size_t>()) {}
+        template<class U>
+        counting_allocator(const counting_allocator<U>& that) noexcept: bytes(that.bytes) {}
+
+        T* allocate(size_t n) {
+            *bytes += n * sizeof(T);
+            return std::allocator<T>().allocate(n);
+        }
+        void deallocate(T* p, size_t n) noexcept {
+            *bytes -= n * sizeof(T);
+            std::allocator<T>().deallocate(p, n);
+        }
+        template<class U>
+        bool operator==(const counting_allocator<U>& that) const noexcept { return bytes == that.bytes; }
+        template<class U>
+        bool operator!=(const counting_allocator<U>& that) const noexcept { return bytes != that.bytes; }
+    };
+
+    using std_map = std::unordered_map<string_view, size_t, std::hash<string_view>, std::equal_to<string_view>,
+        counting_allocator<std::pair<const string_view, size_t>>>;
+
+    template<class Map>
+    void lookup(benchmark::State& state, Map& map) {
+        auto keys = make_keys(size_t(state.range(0)));
+        for(size_t i = 0; i < keys.size(); ++i) map[keys[i]] = i;
+        // every key plus as many misses
+        auto queries = keys;
+        for(auto&& q : make_keys(keys.size(), keys.size())) queries.push_back(q + "!");
+        for(auto _ : state)
+            for(auto&& q : queries) benchmark::DoNotOptimize(map.find(q) == map.end());
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(queries.size()));
+    }
+
+    void view_flat_map_lookup(benchmark::State& state) {
+        view_flat_map<size_t> map;
+        lookup(state, map);
+    }
+
+    void unordered_map_lookup(benchmark::State& state) {
+        std_map map;
+        lookup(state, map);
+    }
+
+    size_t memory_of(const view_flat_map<size_t>& map) { return map.memory_usage(); }
+    size_t memory_of(const std_map& map) { return *map.get_allocator().bytes; }
+
+    template<class Map>
+    void insert(benchmark::State& state) {
+        auto keys = make_keys(size_t(state.range(0)));
+        size_t bytes = 0;
+        for(auto _ : state) {
+            Map map;
+            for(size_t i = 0; i < keys.size(); ++i) map.emplace(keys[i], i);
+            benchmark::DoNotOptimize(map.size());
+            state.PauseTiming();
+            bytes = memory_of(map);
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(keys.size()));
+        state.counters["bytes_per_key"] = double(bytes) / double(keys.size());
+    }
+
+    void view_flat_map_insert(benchmark::State& state) { insert<view_flat_map<size_t>>(state); }
+    void unordered_map_insert(benchmark::State& state) { insert<std_map>(state); }
+
+    BENCHMARK(view_flat_map_lookup)->Range(64, 1 << 20);
+    BENCHMARK(unordered_map_lookup)->Range(64, 1 << 20);
+    BENCHMARK(view_flat_map_insert)->Range(64, 1 << 20);
+    BENCHMARK(unordered_map_insert)->Range(64, 1 << 20);
+}
@@ -0,0 +1,77 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "view_list.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // a response of many small header-like pieces, written to /dev/null
+    struct response_data {
+        std::vector<std::string> names;
+        std::vector<std::string> values;
+        size_t bytes = 0;
+
+        explicit response_data(size_t count) {
+            for(size_t i = 0; i < count; ++i) {
+                names.push_back("X-Field-" + std::to_string(i));
+                values.push_back(std::to_string(i * 7919));
+                bytes += names.back().size() + values.back().size() + 4 + 12;
+            }
+        }
+    };
+
+    void response_ostream(benchmark::State& state) {
+        response_data data(size_t(state.range(0)));
+        std::ofstream out("/dev/null");
+        for(auto _ : state) {
+            for(size_t i = 0; i < data.names.size(); ++i) {
+                out << string_view(data.names[i]) << string_view(": ");
+                out.width(12);
+                out << string_view(data.values[i]) << string_view("\r\n");
+            }
+            out.flush();
+        }
+        state.SetBytesProcessed(int64_t(state.iterations() * data.bytes));
+    }
+
+    void response_writev(benchmark::State& state) {
+        response_data data(size_t(state.range(0)));
+        auto fd = ::open("/dev/null", O_WRONLY);
+        view_list out;
+        for(auto _ : state) {
+            out.clear();
+            for(size_t i = 0; i < data.names.size(); ++i)
+                out.append(data.names[i]).append(": ").append(data.values[i], 12).append("\r\n");
+            benchmark::DoNotOptimize(out.write_to(fd));
+        }
+        ::close(fd);
+        state.SetBytesProcessed(int64_t(state.iterations() * data.bytes));
+    }
+
+    void response_contiguous(benchmark::State& state) {
+        response_data data(size_t(state.range(0)));
+        auto fd = ::open("/dev/null", O_WRONLY);
+        view_list out;
+        std::vector<char> buffer;
+        for(auto _ : state) {
+            out.clear();
+            for(size_t i = 0; i < data.names.size(); ++i)
+                out.append(data.names[i]).append(": ").append(data.values[i], 12).append("\r\n");
+            buffer.resize(out.size());
+            out.copy_to(buffer.data());
+            benchmark::DoNotOptimize(::write(fd, buffer.data(), buffer.size()));
+        }
+        ::close(fd);
+        state.SetBytesProcessed(int64_t(state.iterations() * data.bytes));
+    }
+
+    BENCHMARK(response_ostream)->Arg(100)->Arg(5000);
+    BENCHMARK(response_writev)->Arg(100)->Arg(5000);
+    BENCHMARK(response_contiguous)->Arg(100)->Arg(5000);
+}
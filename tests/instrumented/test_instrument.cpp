@@ -0,0 +1,124 @@
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include "ci_string_view.hpp"
+#include "string_view.hpp"
+
+namespace {
+    using namespace essentials;
+
+    static_assert(view_stats_enabled(), "built with ESSENTIALS_INSTRUMENT");
+    // hooks step aside while constant evaluating
+    constexpr auto constant_hash = string_view_hash()("constexpr"_sv);
+
+    uint64_t kernel_total(const view_op_stats& stats) {
+        uint64_t res = 0;
+        for(auto k : stats.kernels) res += k;
+        return res;
+    }
+
+    TEST(instrument, find) {
+        std::string hay;
+        for(int ix = 0; ix < 16; ++ix) hay += "ayyb";
+        hay += "axxb";
+        string_view v = hay;
+
+        view_stats_reset();
+        ASSERT_EQ(64U, v.find("axxb"));
+        ASSERT_EQ(string_view::npos, v.find("azzb"));
+        ASSERT_EQ(1U, v.find('y'));
+        ASSERT_EQ(string_view::npos, v.find("a", 100));
+
+        auto stats = view_stats_snapshot()[view_op::find];
+        // the out-of-range call never got to scan
+        ASSERT_EQ(3U, stats.calls);
+        ASSERT_EQ(68U + 68U + 2U, stats.scanned);
+        // every "ayyb" passes the anchors and fails verification, "axxb" too the second time
+        ASSERT_EQ(16U + 17U, stats.mismatches);
+        ASSERT_EQ(3U, kernel_total(stats));
+        ASSERT_EQ(1U, stats.kernel(view_kernel::library));
+#ifdef ESSENTIALS_SIMD_X86
+        ASSERT_EQ(2U, stats.kernel(detail::cpu::has_avx2()? view_kernel::avx2 : view_kernel::sse2));
+#endif
+        // 68 code units go to bucket 7, [64, 128)
+        ASSERT_EQ(3U, stats.haystack_sizes[7]);
+        ASSERT_EQ(2U, stats.needle_sizes[3]);
+        ASSERT_EQ(1U, stats.needle_sizes[1]);
+
+        std::string long_hay(300, 'y');
+        ASSERT_EQ(0U, string_view(long_hay).find(std::string(100, 'y')));
+        ASSERT_EQ(1U, view_stats_snapshot()[view_op::find].kernel(view_kernel::two_way));
+    }
+
+    // the case-insensitive kernels are specialized outside string_view.hpp and report all the same
+    TEST(instrument, ci_find) {
+        std::string hay;
+        for(int ix = 0; ix < 16; ++ix) hay += "AyYb";
+        hay += "aXxB";
+        ci_string_view v = ci_string_view(hay.data(), hay.size());
+
+        view_stats_reset();
+        ASSERT_EQ(64U, v.find("axxb"));
+        ASSERT_EQ(ci_string_view::npos, v.find("azzb"));
+        ASSERT_EQ(1U, v.find('Y'));
+
+        auto stats = view_stats_snapshot()[view_op::find];
+        ASSERT_EQ(3U, stats.calls);
+        ASSERT_EQ(16U + 17U, stats.mismatches);
+        ASSERT_EQ(3U, kernel_total(stats));
+        ASSERT_EQ(1U, stats.kernel(view_kernel::library));
+#ifdef ESSENTIALS_SIMD_X86
+        ASSERT_EQ(2U, stats.kernel(detail::cpu::has_avx2()? view_kernel::avx2 : view_kernel::sse2));
+#endif
+    }
+
+    TEST(instrument, other_ops) {
+        string_view v = "key=value; other=thing";
+        view_stats_reset();
+        ASSERT_EQ(9U, v.find_first_of(";="_sv, 4));
+        ASSERT_EQ(16U, v.rfind('='));
+        ASSERT_EQ(9U, v.find_last_of(char_set(";")));
+        ASSERT_EQ(0U, v.find_first_not_of(" "_sv));
+        ASSERT_TRUE(v.substr(0, 3) == "key"_sv);
+        ASSERT_NE(0U, string_view_hash()(v));
+
+        auto stats = view_stats_snapshot();
+        ASSERT_EQ(1U, stats[view_op::find_first_of].calls);
+        ASSERT_EQ(6U, stats[view_op::find_first_of].scanned);
+        ASSERT_EQ(1U, stats[view_op::rfind].calls);
+        ASSERT_EQ(6U, stats[view_op::rfind].scanned);
+        ASSERT_EQ(1U, stats[view_op::find_last_of].calls);
+        ASSERT_EQ(13U, stats[view_op::find_last_of].scanned);
+        ASSERT_EQ(1U, stats[view_op::find_first_not_of].calls);
+        ASSERT_EQ(1U, stats[view_op::compare].calls);
+        ASSERT_EQ(1U, stats[view_op::hash].calls);
+        ASSERT_EQ(v.size(), stats[view_op::hash].scanned);
+        for(auto&& op : stats.ops) ASSERT_EQ(op.calls, kernel_total(op));
+        ASSERT_STREQ("find_last_of", view_op_name(view_op::find_last_of));
+        ASSERT_STREQ("two_way", view_kernel_name(view_kernel::two_way));
+
+        // wide sets allocate, so only a prebuilt one is used
+        u16string_view wide = u"key=value; other=thing";
+        u16string_view many = u";=!#$%&*+-";
+        view_stats_reset();
+        ASSERT_EQ(3U, wide.find_first_of(many));
+        ASSERT_EQ(3U, wide.find_first_of(u16string_view::char_set_type(many)));
+        auto wide_stats = view_stats_snapshot()[view_op::find_first_of];
+        ASSERT_EQ(2U, wide_stats.kernel(view_kernel::scalar));
+        // the scan records its needle, the set has none
+        ASSERT_EQ(1U, wide_stats.needle_sizes[4]);
+        ASSERT_EQ(1U, wide_stats.needle_sizes[0]);
+    }
+
+    TEST(instrument, per_thread) {
+        view_stats_reset();
+        string_view("abc").find("bc");
+        std::thread([] {
+            for(int ix = 0; ix < 10; ++ix) string_view("abc").find("bc");
+            ASSERT_EQ(10U, view_stats_snapshot()[view_op::find].calls);
+        }).join();
+        ASSERT_EQ(1U, view_stats_snapshot()[view_op::find].calls);
+        ASSERT_EQ(std::hash<string_view>()("constexpr"), constant_hash);
+    }
+}
@@ -103,6 +103,16 @@ namespace {
         TEST_CASE(rfind("zz"));
         TEST_CASE(rfind("llop"));
         TEST_CASE(rfind("o", 5));
+        TEST_CASE(rfind("o", 4));
+        TEST_CASE(rfind("l", 3));
+        TEST_CASE(rfind("lo", 3));
+        TEST_CASE(rfind("d"));
+        TEST_CASE(rfind("Hello world"));
+        TEST_CASE(rfind("Hello world!"));
+        TEST_CASE(rfind('l'));
+        TEST_CASE(rfind('l', 3));
+        TEST_CASE(rfind('H', 0));
+        TEST_CASE(rfind('z'));
 
         TEST_CASE(find_first_of("", 8));
         TEST_CASE(find_first_of(""));
@@ -123,6 +133,8 @@ namespace {
         TEST_CASE(find_last_of("llop"));
         TEST_CASE(find_last_of("o", 5));
         TEST_CASE(find_last_of("old", 4));
+        TEST_CASE(find_last_of("o", 4));
+        TEST_CASE(find_last_of('o', 4));
 
         TEST_CASE(find_first_not_of("", 8));
         TEST_CASE(find_first_not_of(""));
@@ -0,0 +1,92 @@
+#include <random>
+#include <string>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+#include "ci_string_view.hpp"
+
+namespace {
+    using namespace essentials;
+
+    std::string lower(std::string s) {
+        for(auto&& c : s) c = ci_char_traits::fold(c);
+        return s;
+    }
+
+    int sign(int x) { return (x > 0) - (x < 0); }
+
+    TEST(ci_string_view, basic) {
+        ci_string_view header = "Content-Type";
+        ASSERT_EQ("content-type"_ci, header);
+        ASSERT_EQ("CONTENT-TYPE", header);
+        ASSERT_NE("content-typ", header);
+        ASSERT_TRUE("accept"_ci < header);
+        ASSERT_TRUE("ACCEPT"_ci < "b"_ci);
+        // '[' sits between 'Z' and 'a': only letters fold
+        ASSERT_TRUE("Z"_ci > "["_ci);
+        ASSERT_FALSE("@"_ci == "`"_ci);
+
+        ASSERT_EQ(8u, header.find("type"));
+        ASSERT_EQ(6u, header.find('T', 4));
+        ASSERT_EQ(4u, header.rfind('E', 9));
+        ASSERT_EQ(7u, header.find_first_of("-"));
+        ASSERT_EQ(3u, header.find_first_of("xT"));
+        ASSERT_EQ(11u, header.find_last_of("E"));
+        ASSERT_EQ(1u, header.find_first_not_of("c"));
+    }
+
+    TEST(ci_string_view, mixed_comparisons) {
+        string_view plain = "SELECT";
+        ci_string_view keyword = "select";
+        ASSERT_TRUE(keyword == plain);
+        ASSERT_TRUE(plain == keyword);
+        ASSERT_FALSE(plain != keyword);
+        ASSERT_TRUE(plain < "UPDATE"_ci);
+        ASSERT_TRUE(as_ci(plain) == "Select");
+        std::string owned = "sElEcT";
+        ASSERT_EQ(keyword, as_ci(owned));
+    }
+
+    TEST(ci_string_view, hash) {
+        std::hash<ci_string_view> hasher;
+        ASSERT_EQ(hasher("X-Forwarded-For"), hasher("x-forwarded-for"));
+        ASSERT_NE(hasher("x-forwarded-for"), hasher("x-forwarded-fox"));
+        std::unordered_set<ci_string_view> headers{ "Host", "Accept", "Content-Length" };
+        ASSERT_EQ(1u, headers.count("HOST"));
+        ASSERT_EQ(1u, headers.count("content-length"));
+        ASSERT_EQ(0u, headers.count("content-lengths"));
+        // constant evaluation works as for plain views
+        constexpr auto h = ci_string_view_hash(1)("KEY"_ci);
+        ASSERT_EQ(h, ci_string_view_hash(1)("key"));
+    }
+
+    TEST(ci_string_view, random_equivalence) {
+        std::mt19937 rng(13);
+        const char alphabet[] = "aAbB[`@zZ\x80\xc1";
+        auto random = [&](size_t size) {
+            std::string res(size, 'a');
+            for(auto&& c : res) c = alphabet[rng() % (sizeof(alphabet) - 1)];
+            return res;
+        };
+        for(int iteration = 0; iteration < 2000; ++iteration) {
+            auto hay = random(rng() % 200);
+            auto needle = random(1 + rng() % (iteration % 10 == 0? 100 : 5));
+            auto lhay = lower(hay), lneedle = lower(needle);
+            ci_string_view ch(hay.data(), hay.size()), cn(needle.data(), needle.size());
+
+            ASSERT_EQ(lhay.find(lneedle), ch.find(cn));
+            ASSERT_EQ(lhay.rfind(lneedle), ch.rfind(cn));
+            ASSERT_EQ(lhay.find(lneedle[0]), ch.find(needle[0]));
+            ASSERT_EQ(lhay.find_first_of(lneedle), ch.find_first_of(cn));
+            ASSERT_EQ(lhay.find_last_not_of(lneedle), ch.find_last_not_of(cn));
+
+            auto other = random(hay.size());
+            ASSERT_EQ(sign(lhay.compare(lower(other))), sign(ch.compare(ci_string_view(other.data(), other.size()))));
+            ASSERT_EQ(lhay == lower(other), ch == as_ci(other));
+            if(lhay == lower(other)) {
+                ASSERT_EQ(std::hash<ci_string_view>()(ch), std::hash<ci_string_view>()(as_ci(other)));
+            }
+        }
+    }
+
+}
@@ -0,0 +1,106 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "csv_scanner.hpp"
+
+namespace {
+    using namespace essentials;
+
+    using table = std::vector<std::vector<std::string>>;
+
+    table scan(string_view data, csv_dialect dialect = csv_dialect()) {
+        table res;
+        csv_scanner scanner(data, dialect);
+        while(scanner.next()) {
+            res.emplace_back();
+            for(auto&& field : scanner.record()) res.back().push_back(field.str());
+        }
+        return res;
+    }
+
+    TEST(csv_scanner, basic) {
+        ASSERT_EQ((table{ { "a", "b", "c" }, { "1", "", "3" } }), scan("a,b,c\n1,,3\n"));
+        ASSERT_EQ((table{ { "a", "b" }, { "x", "" } }), scan("a,b\r\nx,"));
+        ASSERT_EQ((table{ { "say \"hi\"", "a,b", "line\nbreak" } }), scan("\"say \"\"hi\"\"\",\"a,b\",\"line\nbreak\"\n"));
+        ASSERT_EQ((table{ { "" }, { "x" } }), scan("\nx"));
+        ASSERT_EQ(table{}, scan(""));
+
+        csv_dialect tsv;
+        tsv.delimiter = '\t';
+        tsv.quote = '\'';
+        tsv.crlf = false;
+        ASSERT_EQ((table{ { "a,b", "it's", "c\r" } }), scan("a,b\t'it''s'\tc\r", tsv));
+    }
+
+    TEST(csv_scanner, lazy_fields) {
+        csv_scanner scanner("plain,\"quoted\",\"with \"\"escapes\"\"\"");
+        ASSERT_TRUE(scanner.next());
+        auto record = scanner.record();
+        ASSERT_EQ(3U, record.size());
+        ASSERT_FALSE(record[0].quoted());
+        ASSERT_EQ("quoted"_sv, record[1].value());
+        ASSERT_FALSE(record[1].escaped());
+        ASSERT_TRUE(record[2].escaped());
+        ASSERT_EQ("with \"\"escapes\"\""_sv, record[2].value());
+        std::string buffer;
+        ASSERT_EQ("with \"escapes\""_sv, record[2].unescape(buffer));
+        // nothing to undo, nothing copied
+        ASSERT_EQ(record[1].value().data(), record[1].unescape(buffer).data());
+        ASSERT_FALSE(scanner.next());
+    }
+
+    TEST(csv_scanner, round_trip) {
+        // random tables written out with quoting where needed (always for empty fields, so no blank lines), across block boundaries
+        std::mt19937 rng{ 11U };
+        const char alphabet[] = { 'a', 'b', ',', '"', '\n', '\r', ' ', ';' };
+        for(int iteration = 0; iteration < 300; ++iteration) {
+            csv_dialect dialect;
+            if(iteration % 3 == 0) dialect.delimiter = ';';
+            table expected(1 + rng() % 20);
+            std::string data;
+            for(auto&& row : expected) {
+                row.resize(1 + rng() % 6);
+                for(size_t ix = 0; ix < row.size(); ++ix) {
+                    auto&& field = row[ix];
+                    field.resize(rng() % 12);
+                    for(auto&& c : field) c = alphabet[rng() % sizeof(alphabet)];
+                    if(ix != 0) data += dialect.delimiter;
+                    if(field.find_first_of("\"\r\n,;") == std::string::npos && !field.empty()) data += field;
+                    else {
+                        data += '"';
+                        for(auto c : field) data.append((c == '"')? 2 : 1, c);
+                        data += '"';
+                    }
+                }
+                data += (rng() % 2)? "\r\n" : "\n";
+            }
+            ASSERT_EQ(expected, scan(data, dialect)) << data;
+        }
+    }
+
+    TEST(csv_scanner, kernels) {
+        std::mt19937 rng{ 3U };
+        for(int iteration = 0; iteration < 200; ++iteration) {
+            char block[64];
+            for(auto&& c : block) c = "a,\"\n"[rng() % 4];
+            auto scalar = detail::csv_classify_scalar(block, ',', '"');
+            uint64_t bits = uint64_t(rng()) << 32 | rng();
+#ifdef ESSENTIALS_SIMD_X86
+            auto sse2 = detail::csv_classify_sse2(block, ',', '"');
+            ASSERT_EQ(scalar.quote, sse2.quote);
+            ASSERT_EQ(scalar.structural, sse2.structural);
+            if(detail::cpu::has_avx2()) {
+                auto avx2 = detail::csv_classify_avx2(block, ',', '"');
+                ASSERT_EQ(scalar.quote, avx2.quote);
+                ASSERT_EQ(scalar.structural, avx2.structural);
+            }
+            if(detail::cpu::has_pclmul()) {
+                ASSERT_EQ(detail::prefix_xor(bits), detail::prefix_xor_clmul(bits));
+            }
+#endif
+            ASSERT_EQ(bits & 1, detail::prefix_xor(bits) & 1);
+        }
+    }
+}
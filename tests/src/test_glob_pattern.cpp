@@ -0,0 +1,146 @@
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "glob_pattern.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // the textbook backtracking matcher, over '*', '?' and literals
+    bool naive_match(const char* p, const char* pend, const char* s, const char* send) {
+        if(p == pend) return s == send;
+        if(*p == '*') {
+            for(auto at = s; ; ++at) {
+                if(naive_match(p + 1, pend, at, send)) return true;
+                if(at == send) return false;
+            }
+        }
+        if(s == send || (*p != '?' && *p != *s)) return false;
+        return naive_match(p + 1, pend, s + 1, send);
+    }
+
+    bool naive_match(const std::string& p, const std::string& s) {
+        return naive_match(p.data(), p.data() + p.size(), s.data(), s.data() + s.size());
+    }
+
+    TEST(glob_pattern, basics) {
+        glob_pattern host("*.example.com");
+        ASSERT_TRUE(host.match("www.example.com"));
+        ASSERT_TRUE(host.match(".example.com"));
+        ASSERT_TRUE(host.match("a.b.example.com"));
+        ASSERT_FALSE(host.match("example.com"));
+        ASSERT_FALSE(host.match("www.example.org"));
+        ASSERT_FALSE(host.match(""));
+        ASSERT_EQ(".example.com"_sv, host.literal());
+
+        glob_pattern route("/api/*/items?");
+        ASSERT_TRUE(route("/api/v1/items/"));
+        ASSERT_TRUE(route("/api//itemsX"));
+        ASSERT_TRUE(route("/api/a/b/items1"));
+        ASSERT_FALSE(route("/api/v1/items"));
+        ASSERT_FALSE(route("/api/items1"));
+        ASSERT_EQ(12U, route.min_size());
+
+        glob_pattern middle("a*needle*z");
+        ASSERT_TRUE(middle.match("a__needle__z"));
+        ASSERT_TRUE(middle.match("aneedlez"));
+        ASSERT_FALSE(middle.match("a__needl__z"));
+        ASSERT_FALSE(middle.match("aneedle"));
+
+        ASSERT_TRUE(glob_pattern("").match(""));
+        ASSERT_FALSE(glob_pattern("").match("a"));
+        ASSERT_TRUE(glob_pattern("***").match(""));
+        ASSERT_TRUE(glob_pattern("a**b").match("ab"));
+        ASSERT_TRUE(glob_pattern("exact").is_literal());
+        ASSERT_FALSE(glob_pattern("exa?t").is_literal());
+        ASSERT_FALSE(glob_pattern("exact").match("exactly"));
+    }
+
+    TEST(glob_pattern, classes_and_escapes) {
+        glob_pattern digits("v[0-9][0-9]");
+        ASSERT_TRUE(digits.match("v42"));
+        ASSERT_FALSE(digits.match("v4x"));
+        glob_pattern not_slash("/[!/]*");
+        ASSERT_TRUE(not_slash.match("/a/b"));
+        ASSERT_FALSE(not_slash.match("//b"));
+        ASSERT_TRUE(glob_pattern("[^a]").match("b"));
+        ASSERT_TRUE(glob_pattern("[]a]").match("]"));
+        ASSERT_TRUE(glob_pattern("[a-]").match("-"));
+        ASSERT_TRUE(glob_pattern("*[xyz]*").match("__y__"));
+        ASSERT_FALSE(glob_pattern("*[xyz]*").match("_____"));
+
+        glob_pattern escaped("\\*\\?\\[*");
+        ASSERT_TRUE(escaped.match("*?[anything"));
+        ASSERT_FALSE(escaped.match("x?[anything"));
+        ASSERT_EQ("*?["_sv, escaped.literal());
+
+        ASSERT_THROW(glob_pattern("[abc"), std::invalid_argument);
+        ASSERT_THROW(glob_pattern("abc\\"), std::invalid_argument);
+        ASSERT_THROW(glob_pattern("[!]"), std::invalid_argument);
+    }
+
+    TEST(glob_pattern, no_backtracking) {
+        // exponential for the naive matcher
+        std::string input(5000, 'a');
+        glob_pattern pattern("*a*a*a*a*a*a*a*a*a*a*b");
+        ASSERT_FALSE(pattern.match(input));
+        input.back() = 'b';
+        ASSERT_TRUE(pattern.match(input));
+    }
+
+    TEST(glob_pattern, against_naive) {
+        std::mt19937 rng{ 11U };
+        auto random_string = [&](size_t max, const char* alphabet, size_t letters) {
+            std::string res(rng() % max, 'a');
+            for(auto&& c : res) c = alphabet[rng() % letters];
+            return res;
+        };
+        for(size_t round = 0; round < 3000; ++round) {
+            auto p = random_string(10, "ab*?", 4);
+            glob_pattern pattern(p);
+            for(size_t jx = 0; jx < 20; ++jx) {
+                auto s = random_string(14, "ab", 2);
+                ASSERT_EQ(naive_match(p, s), pattern.match(s)) << p << " " << s;
+            }
+        }
+    }
+
+    TEST(glob_set, matches) {
+        glob_set rules{ "*.example.com", "/api/*/items?", "*", "www.*", "*.org", "*example*" };
+        ASSERT_EQ(6U, rules.size());
+        ASSERT_EQ((std::vector<size_t>{ 0, 2, 3, 5 }), rules.match("www.example.com"));
+        ASSERT_EQ((std::vector<size_t>{ 1, 2 }), rules.match("/api/v2/items1"));
+        ASSERT_EQ((std::vector<size_t>{ 2, 4, 5 }), rules.match("example.org"));
+        ASSERT_TRUE(rules.match_any("anything"));
+
+        glob_set strict{ "*.example.com", "*.example.com", "/static/*.css" };
+        ASSERT_EQ((std::vector<size_t>{ 0, 1 }), strict.match("a.example.com"));
+        ASSERT_TRUE(strict.match("a.example.org").empty());
+        ASSERT_FALSE(strict.match_any("/static/a.js"));
+        ASSERT_TRUE(strict.match_any("/static/a.css"));
+        ASSERT_FALSE(glob_set(std::vector<glob_pattern>()).match_any(""));
+    }
+
+    TEST(glob_set, against_patterns) {
+        std::mt19937 rng{ 5U };
+        auto random_string = [&](size_t max, const char* alphabet, size_t letters) {
+            std::string res(rng() % max, 'a');
+            for(auto&& c : res) c = alphabet[rng() % letters];
+            return res;
+        };
+        std::vector<std::string> sources;
+        for(size_t ix = 0; ix < 60; ++ix) sources.push_back(random_string(8, "abc*?", 5));
+        glob_set set(sources.begin(), sources.end());
+        for(size_t round = 0; round < 2000; ++round) {
+            auto s = random_string(16, "abc", 3);
+            std::vector<size_t> expected;
+            for(size_t ix = 0; ix < sources.size(); ++ix)
+                if(naive_match(sources[ix], s)) expected.push_back(ix);
+            ASSERT_EQ(expected, set.match(s)) << s;
+            ASSERT_EQ(!expected.empty(), set.match_any(s));
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+#include "string_view.hpp"
+
+namespace {
+    using namespace essentials;
+
+    TEST(hash, deterministic) {
+        std::string s0 = "hello world";
+        std::string s1 = "hello world";
+        std::hash<string_view> hasher;
+        ASSERT_EQ(hasher(s0), hasher(s1));
+        ASSERT_EQ(hasher(string_view(s0).substr(6)), hasher("world"));
+        ASSERT_NE(hasher("hello"), hasher("hellp"));
+        ASSERT_NE(hasher(""), hasher(string_view("\0", 1)));
+    }
+
+    TEST(hash, all_lengths_distinct) {
+        std::mt19937 rng(3);
+        std::string text;
+        for(int i = 0; i < 300; ++i) text += char('a' + rng() % 26);
+        std::unordered_set<size_t> seen;
+        string_view vt = text;
+        for(size_t len = 0; len <= text.size(); ++len)
+            ASSERT_TRUE(seen.insert(std::hash<string_view>{}(vt.substr(0, len))).second) << len;
+        for(size_t off = 1; off < text.size(); ++off)
+            ASSERT_TRUE(seen.insert(std::hash<string_view>{}(vt.substr(off))).second) << off;
+    }
+
+    TEST(hash, seeds) {
+        string_view_hash h0;
+        string_view_hash h1(1);
+        string_view_hash hr(random_hash_seed());
+        ASSERT_EQ(h0("key"), std::hash<string_view>{}("key"));
+        ASSERT_NE(h0("key"), h1("key"));
+        ASSERT_EQ(h1("key"), string_view_hash(1)("key"));
+        ASSERT_EQ(hr.seed(), random_hash_seed());
+    }
+
+    TEST(hash, char_types) {
+        const unsigned char bytes[] = { 'k', 'e', 'y', 0xff };
+        ASSERT_EQ(std::hash<string_view>{}(string_view("key\xff", 4)),
+                  std::hash<basic_string_view<unsigned char>>{}(basic_string_view<unsigned char>(bytes, 4)));
+
+        std::hash<u16string_view> h16;
+        std::hash<u32string_view> h32;
+        std::hash<wstring_view> hw;
+        ASSERT_EQ(h16(u"symbol table"), h16(std::u16string(u"symbol table")));
+        ASSERT_NE(h16(u"symbol table"), h16(u"symbol tablf"));
+        ASSERT_EQ(h32(U"symbol table"), h32(std::u32string(U"symbol table")));
+        ASSERT_EQ(hw(L"symbol table"), hw(std::wstring(L"symbol table")));
+
+        // the same content through any code unit
+        std::hash<string_view> h8;
+        ASSERT_EQ(h8("abc"), h16(u"abc"));
+        ASSERT_EQ(h8("abc"), h32(U"abc"));
+        ASSERT_EQ(h8("abc"), hw(L"abc"));
+        std::string text;
+        std::u16string text16;
+        std::u32string text32;
+        for(unsigned ix = 0; ix < 200; ++ix) {
+            text += char('a' + ix % 26);
+            text16 += char16_t('a' + ix % 26);
+            text32 += char32_t('a' + ix % 26);
+            ASSERT_EQ(h8(text), h16(text16)) << ix;
+            ASSERT_EQ(h8(text), h32(text32)) << ix;
+        }
+        ASSERT_EQ(h8("caf\xe9"), h16(u"caf\u00e9"));
+        ASSERT_EQ(h16(u"\u4e2d\u6587 text"), h32(U"\u4e2d\u6587 text"));
+        ASSERT_EQ(h16(u"\uffff\u0100"), h32(U"\uffff\u0100"));
+        // units past a byte are not folded onto their low one
+        ASSERT_NE(h16(u"\u0161"), h16(u"a"));
+        ASSERT_NE(h16(u"\u4e2d\u6587"), h16(u"\u4e2e\u6587"));
+        ASSERT_NE(h32(U"\U0001f600"), h32(U"\uf600"));
+        basic_string_view_hash<char16_t, std::char_traits<char16_t>, fnv1a_policy> fnv16;
+        basic_string_view_hash<char, std::char_traits<char>, fnv1a_policy> fnv8;
+        ASSERT_EQ(fnv8("abc"), fnv16(u"abc"));
+        ASSERT_NE(fnv16(u"\u0161"), fnv16(u"a"));
+    }
+
+    TEST(hash, policies) {
+        basic_string_view_hash<char, std::char_traits<char>, fnv1a_policy> fnv;
+        // FNV-1a 64 reference values
+        ASSERT_EQ(size_t(0xcbf29ce484222325ULL), fnv(""));
+        ASSERT_EQ(size_t(0xaf63dc4c8601ec8cULL), fnv("a"));
+        ASSERT_EQ(size_t(0x85944171f73967e8ULL), fnv("foobar"));
+    }
+
+    TEST(hash, constexpr_evaluation) {
+        constexpr auto h = string_view_hash()("constexpr"_sv);
+        ASSERT_EQ(h, std::hash<string_view>{}("constexpr"));
+    }
+
+    TEST(hash, unordered_map) {
+        std::unordered_map<string_view, int> symbols;
+        std::vector<std::string> storage;
+        for(int i = 0; i < 1000; ++i) storage.push_back("symbol_" + std::to_string(i));
+        for(int i = 0; i < 1000; ++i) symbols[storage[i]] = i;
+        ASSERT_EQ(1000, symbols.size());
+        ASSERT_EQ(42, symbols["symbol_42"]);
+        ASSERT_EQ(0, symbols.count("symbol_1000"));
+    }
+
+}
@@ -0,0 +1,81 @@
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+#include "intern_pool.hpp"
+
+namespace {
+    using namespace essentials;
+
+    TEST(hashed_string_view, basic) {
+        constexpr hashed_string_view host = "Host"_sv;
+        static_assert(host.hash() == string_view_hash()("Host"_sv), "hash is computed at compile time");
+        ASSERT_EQ(host.hash(), std::hash<string_view>{}("Host"));
+        ASSERT_EQ(host, hashed_string_view("Host"));
+        ASSERT_NE(host, hashed_string_view("host"));
+        ASSERT_TRUE(hashed_string_view("abc") < hashed_string_view("abd"));
+        ASSERT_EQ(string_view("Host"), host.view());
+        ASSERT_EQ(4, host.size());
+        ASSERT_EQ(hashed_string_view(), hashed_string_view(""));
+        ASSERT_EQ(host.hash(), std::hash<hashed_string_view>{}(host));
+    }
+
+    TEST(hashed_string_view, unordered_map) {
+        std::unordered_map<hashed_string_view, int> headers;
+        headers["Host"_sv] = 1;
+        headers["Accept"_sv] = 2;
+        ASSERT_EQ(1, headers.at("Host"_sv));
+        ASSERT_EQ(2, headers.at(hashed_string_view(std::string("Accept"))));
+        ASSERT_EQ(0, headers.count("Cookie"_sv));
+    }
+
+    TEST(intern_pool, shares_storage) {
+        intern_pool pool;
+        std::string s0 = "content-type";
+        std::string s1 = "content-type";
+        auto i0 = pool.intern(s0);
+        auto i1 = pool.intern(string_view(s1));
+        ASSERT_EQ(i0.data(), i1.data());
+        ASSERT_NE(i0.data(), s0.data());
+        ASSERT_EQ(i0, i1);
+        ASSERT_EQ(1, pool.size());
+
+        s0[0] = 'C';
+        ASSERT_EQ(string_view("content-type"), i0.view());
+
+        auto other = pool.intern("content-length"_sv);
+        ASSERT_NE(other, i0);
+        ASSERT_EQ(2, pool.size());
+
+        ASSERT_TRUE(pool.contains("content-length"_sv));
+        ASSERT_FALSE(pool.contains("content-md5"_sv));
+        ASSERT_EQ(other.data(), pool.find("content-length"_sv).data());
+        ASSERT_EQ(nullptr, pool.find("content-md5"_sv).data());
+
+        ASSERT_TRUE(pool.intern(""_sv).empty());
+        ASSERT_TRUE(pool.contains(""_sv));
+    }
+
+    TEST(intern_pool, many_tokens) {
+        intern_pool pool(4096);
+        std::vector<hashed_string_view> interned;
+        for(int i = 0; i < 20000; ++i) interned.push_back(pool.intern(std::to_string(i * 7919)));
+        ASSERT_EQ(20000, pool.size());
+        // a handful of chunks instead of one allocation per string
+        ASSERT_LT(pool.chunks(), 50);
+        for(int i = 0; i < 20000; ++i) {
+            auto again = pool.intern(std::to_string(i * 7919));
+            ASSERT_EQ(interned[i].data(), again.data());
+        }
+        ASSERT_EQ(20000, pool.size());
+
+        std::string big(10000, 'x');
+        auto ib = pool.intern(big);
+        ASSERT_EQ(string_view(big), ib.view());
+        ASSERT_EQ(ib.data(), pool.intern(big).data());
+
+        pool.clear();
+        ASSERT_TRUE(pool.empty());
+        ASSERT_FALSE(pool.contains("7919"_sv));
+    }
+
+}
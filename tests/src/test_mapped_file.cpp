@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include "mapped_file.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // a file in /tmp removed on scope exit
+    struct temp_file {
+        std::string path;
+
+        explicit temp_file(const std::string& content) {
+            char name[] = "/tmp/string_view_test_XXXXXX";
+            auto fd = mkstemp(name);
+            path = name;
+            if(fd >= 0) {
+                auto written = ::write(fd, content.data(), content.size());
+                (void) written;
+                ::close(fd);
+            }
+        }
+        ~temp_file() { std::remove(path.c_str()); }
+    };
+
+    TEST(mapped_file, view) {
+        std::string content;
+        for(int i = 0; i < 10000; ++i) content += "record " + std::to_string(i) + "\n";
+        temp_file file(content);
+
+        mapped_file mf(file.path, map_advice::sequential, true);
+        ASSERT_TRUE(mf.is_mapped());
+        ASSERT_EQ(content.size(), mf.size());
+        ASSERT_EQ(string_view(content), mf.view());
+        ASSERT_EQ(content.find("record 9999"), mf.view().find("record 9999"));
+        ASSERT_EQ(content.rfind('\n', 100), mf.view().rfind('\n', 100));
+
+        size_t count = 0;
+        for(auto line : mf.lines()) {
+            ASSERT_EQ("record " + std::to_string(count), line);
+            ++count;
+        }
+        ASSERT_EQ(10000u, count);
+
+        mapped_file moved = std::move(mf);
+        ASSERT_FALSE(mf.is_mapped());
+        ASSERT_EQ(string_view(content), string_view(moved));
+        moved.advise(map_advice::willneed);
+        moved.unmap();
+        ASSERT_TRUE(moved.empty());
+    }
+
+    TEST(mapped_file, empty_and_missing) {
+        temp_file file("");
+        mapped_file mf(file.path);
+        ASSERT_TRUE(mf.empty());
+        ASSERT_TRUE(mf.lines().begin() == mf.lines().end());
+
+        ASSERT_THROW(mapped_file("/nonexistent/string_view/file"), std::system_error);
+    }
+
+    TEST(lines, basic) {
+        std::vector<std::string> res;
+        for(auto line : lines("a\r\nb\n\nc"_sv)) res.push_back(line);
+        ASSERT_EQ(std::vector<std::string>({ "a", "b", "", "c" }), res);
+
+        res.clear();
+        for(auto line : lines("a\nb\n"_sv)) res.push_back(line);
+        ASSERT_EQ(std::vector<std::string>({ "a", "b" }), res);
+
+        res.clear();
+        for(auto line : lines("\n\r\n"_sv)) res.push_back(line);
+        ASSERT_EQ(std::vector<std::string>({ "", "" }), res);
+
+        ASSERT_TRUE(lines(""_sv).begin() == lines(""_sv).end());
+    }
+
+}
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <random>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include "multi_searcher.hpp"
+
+namespace {
+    using namespace essentials;
+    using match = multi_searcher::match;
+
+    std::vector<match> brute_force(const std::vector<std::string>& patterns, const std::string& hay) {
+        std::vector<match> res;
+        for(size_t off = 0; off < hay.size(); ++off)
+            for(size_t ix = 0; ix < patterns.size(); ++ix)
+                if(!patterns[ix].empty() && hay.compare(off, patterns[ix].size(), patterns[ix]) == 0)
+                    res.push_back(match{ ix, off });
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+
+    std::string random_string(std::mt19937& rng, size_t size, char alphabet) {
+        std::string res(size, 'a');
+        for(auto&& c : res) c = char('a' + rng() % size_t(alphabet - 'a' + 1));
+        return res;
+    }
+
+    void check_engines(const std::vector<std::string>& patterns, const std::string& hay) {
+        auto expected = brute_force(patterns, hay);
+        for(auto kind : { multi_searcher::engine::teddy, multi_searcher::engine::aho_corasick }) {
+            multi_searcher ms(patterns.begin(), patterns.end(), kind);
+            ASSERT_EQ(expected, ms.find_all(hay));
+            auto first = ms.find_first(hay);
+            if(expected.empty()) {
+                ASSERT_EQ(multi_searcher::npos, first.offset);
+                ASSERT_FALSE(ms.contains_any(hay));
+            } else {
+                ASSERT_EQ(expected.front(), first);
+                ASSERT_TRUE(ms.contains_any(hay));
+            }
+        }
+    }
+
+    TEST(multi_searcher, small_sets) {
+        std::mt19937 rng(5);
+        for(int iteration = 0; iteration < 300; ++iteration) {
+            auto alphabet = char('a' + rng() % 4);
+            std::vector<std::string> patterns;
+            auto count = 1 + rng() % 20;
+            for(size_t ix = 0; ix < count; ++ix) patterns.push_back(random_string(rng, 1 + rng() % 6, alphabet));
+            check_engines(patterns, random_string(rng, rng() % 300, alphabet));
+        }
+    }
+
+    TEST(multi_searcher, large_sets) {
+        std::mt19937 rng(6);
+        for(int iteration = 0; iteration < 10; ++iteration) {
+            std::vector<std::string> patterns;
+            for(size_t ix = 0; ix < 500; ++ix) patterns.push_back(random_string(rng, 2 + rng() % 10, 'f'));
+            check_engines(patterns, random_string(rng, 2000, 'f'));
+        }
+    }
+
+    TEST(multi_searcher, keywords) {
+        multi_searcher ms{ "error", "warn", "err", "timeout", "" };
+        ASSERT_EQ(5, ms.size());
+        ASSERT_EQ("warn"_sv, ms.pattern(1));
+        ASSERT_LE(ms.size(), multi_searcher::teddy_limit);
+        auto all = ms.find_all("warning: error after timeout, no error");
+        std::vector<match> expected{ { 1, 0 }, { 0, 9 }, { 2, 9 }, { 3, 21 }, { 0, 33 }, { 2, 33 } };
+        ASSERT_EQ(expected, all);
+        ASSERT_EQ((match{ 0, 3 }), ms.find_first("an error"));
+        ASSERT_EQ((match{ 2, 0 }), ms.find_first("err"));
+        ASSERT_FALSE(ms.contains_any("all good"));
+        ASSERT_FALSE(ms.contains_any(""));
+
+        // the scan stops at the first match the predicate accepts
+        size_t last = 0;
+        ASSERT_TRUE(ms.any_match("warning: error after timeout", [&last](match m) { last = std::max(last, m.offset); return m.pattern == 0; }));
+        ASSERT_EQ(9U, last);
+        ASSERT_FALSE(ms.any_match("warning: err", [](match m) { return m.pattern == 3; }));
+
+        multi_searcher none(std::vector<string_view>{});
+        ASSERT_TRUE(none.find_all("anything").empty());
+        ASSERT_FALSE(none.contains_any("anything"));
+    }
+
+    TEST(multi_searcher, binary_bytes) {
+        std::vector<std::string> patterns{ std::string("\xff\x00\x80", 3), "\x7f", std::string("\0", 1) };
+        std::string hay("abc\xff\x00\x80\x7f\x00zz", 10);
+        check_engines(patterns, hay);
+    }
+
+    TEST(multi_searcher, find_first_stops_early) {
+        // the haystack runs on into inaccessible pages: touching them past the first match faults
+        auto page = size_t(sysconf(_SC_PAGESIZE));
+        auto memory = static_cast<char*>(mmap(nullptr, 4 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        ASSERT_NE(MAP_FAILED, static_cast<void*>(memory));
+        std::fill(memory, memory + page, '.');
+        std::memcpy(memory + 100, "hello", 5);
+        ASSERT_EQ(0, mprotect(memory + page, 3 * page, PROT_NONE));
+        string_view hay(memory, 4 * page);
+
+        std::vector<std::string> patterns{ "hello", "world" };
+        for(size_t ix = 0; ix < 40; ++ix) patterns.push_back("absent" + std::to_string(ix));
+        for(auto kind : { multi_searcher::engine::teddy, multi_searcher::engine::aho_corasick }) {
+            multi_searcher ms(patterns.begin(), patterns.end(), kind);
+            ASSERT_EQ((match{ 0, 100 }), ms.find_first(hay));
+            ASSERT_TRUE(ms.contains_any(hay));
+            ASSERT_TRUE(ms.any_match(hay, [](match m) { return m.pattern == 0; }));
+        }
+        munmap(memory, 4 * page);
+    }
+}
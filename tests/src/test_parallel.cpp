@@ -0,0 +1,106 @@
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "parallel.hpp"
+
+namespace {
+    using namespace essentials;
+
+    std::vector<size_t> find_all(string_view hay, string_view needle) {
+        std::vector<size_t> res;
+        for(auto pos = hay.find(needle); pos != string_view::npos; pos = hay.find(needle, pos + 1)) res.push_back(pos);
+        return res;
+    }
+
+    template<class Executor>
+    void check_chunks(Executor& executor) {
+        std::mt19937 rng(11);
+        for(int iteration = 0; iteration < 200; ++iteration) {
+            std::string hay(rng() % 2000, 'a');
+            for(auto&& c : hay) c = char('a' + rng() % 3);
+            std::string needle(1 + rng() % 6, 'a');
+            for(auto&& c : needle) c = char('a' + rng() % 3);
+            // tiny chunks, so that plenty of matches straddle the boundaries
+            auto chunk = 1 + rng() % 64;
+            auto expected = find_all(hay, needle);
+
+            ASSERT_EQ(string_view(hay).find(needle), parallel_find(string_view(hay), needle, executor, chunk));
+            ASSERT_EQ(expected, parallel_find_all(string_view(hay), needle, executor, chunk));
+            ASSERT_EQ(expected.size(), parallel_count(string_view(hay), needle, executor, chunk));
+            ASSERT_EQ(find_all(hay, "b"), parallel_find_all(string_view(hay), 'b', executor, chunk));
+        }
+    }
+
+    TEST(parallel, inline_executor) {
+        inline_executor executor;
+        check_chunks(executor);
+    }
+
+    TEST(parallel, thread_pool) {
+        thread_pool pool(4);
+        ASSERT_EQ(4u, pool.size());
+        check_chunks(pool);
+    }
+
+    TEST(parallel, nested_and_defaults) {
+        std::string hay(3u << 20, 'x');
+        hay.replace(hay.size() - 5, 5, "hello");
+        hay.replace(1000, 5, "hello");
+        string_view v = hay;
+        ASSERT_EQ(1000u, parallel_find(v, "hello"));
+        ASSERT_EQ(2u, parallel_count(v, "hello"));
+        ASSERT_EQ(std::vector<size_t>({ 1000, hay.size() - 5 }), parallel_find_all(v, "hello"));
+        ASSERT_EQ(1000u, parallel_find(v, 'h'));
+        ASSERT_EQ(0u, parallel_count(v, ""));
+        ASSERT_EQ(string_view::npos, parallel_find(v, "absent"));
+
+        // a search started from inside a pool task has the caller take all chunks if need be
+        thread_pool pool(1);
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t count = 0;
+        bool finished = false;
+        pool.execute([&] {
+            auto res = parallel_count(v, "hello", pool, 4096);
+            std::lock_guard<std::mutex> lock(mutex);
+            count = res;
+            finished = true;
+            done.notify_all();
+        });
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return finished; });
+        ASSERT_EQ(2u, count);
+    }
+
+    TEST(parallel, exceptions) {
+        thread_pool pool(3);
+        std::atomic<size_t> calls{ 0 };
+        auto throwing = [&calls](size_t ix) {
+            ++calls;
+            if(ix == 5) throw std::runtime_error("chunk 5");
+        };
+        ASSERT_THROW(detail::parallel_chunks(pool, 1000, throwing), std::runtime_error);
+        ASSERT_LE(calls.load(), 1000u);
+        inline_executor executor;
+        ASSERT_THROW(detail::parallel_chunks(executor, 10, throwing), std::runtime_error);
+
+        // a throwing task keeps its worker, the exception waits for the owner
+        thread_pool single(1);
+        single.execute([] { throw std::logic_error("task"); });
+        bool thrown = false;
+        for(int attempt = 0; attempt < 10000 && !thrown; ++attempt) {
+            try {
+                single.rethrow_failure();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            } catch(const std::logic_error&) {
+                thrown = true;
+            }
+        }
+        ASSERT_TRUE(thrown);
+        ASSERT_EQ(2u, parallel_count(string_view("abcabc"), "bc", single, 1));
+        ASSERT_NO_THROW(single.rethrow_failure());
+    }
+}
@@ -0,0 +1,164 @@
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "parse_number.hpp"
+
+namespace {
+    using namespace essentials;
+
+    TEST(parse_number, int) {
+        auto r = parse_int<int>("12345,");
+        ASSERT_TRUE(bool(r));
+        ASSERT_EQ(12345, r.value);
+        ASSERT_EQ(5, r.consumed);
+
+        ASSERT_EQ(-42, parse_int<int>("-42").value);
+        ASSERT_EQ(parse_errc::invalid, parse_int<unsigned>("-42").error);
+        ASSERT_EQ(parse_errc::invalid, parse_int<int>("+42").error);
+        ASSERT_EQ(parse_errc::invalid, parse_int<int>("").error);
+        ASSERT_EQ(parse_errc::invalid, parse_int<int>("-").error);
+        ASSERT_EQ(parse_errc::invalid, parse_int<int>(" 1").error);
+        ASSERT_EQ(0, parse_int<int>("x").consumed);
+
+        ASSERT_EQ(std::numeric_limits<int64_t>::min(), parse_int<int64_t>("-9223372036854775808").value);
+        ASSERT_EQ(std::numeric_limits<int64_t>::max(), parse_int<int64_t>("9223372036854775807").value);
+        ASSERT_EQ(parse_errc::out_of_range, parse_int<int64_t>("9223372036854775808").error);
+        ASSERT_EQ(std::numeric_limits<uint64_t>::max(), parse_int<uint64_t>("18446744073709551615").value);
+        auto big = parse_int<uint64_t>("18446744073709551616;");
+        ASSERT_EQ(parse_errc::out_of_range, big.error);
+        ASSERT_EQ(20, big.consumed);
+        ASSERT_EQ(parse_errc::out_of_range, parse_int<uint64_t>("123456789012345678901234567890").error);
+        ASSERT_EQ(-128, parse_int<int8_t>("-128").value);
+        ASSERT_EQ(parse_errc::out_of_range, parse_int<int8_t>("128").error);
+        ASSERT_EQ(255, parse_int<uint8_t>("255").value);
+        ASSERT_EQ(7, parse_int<int>("00000000000000000000000007").value);
+
+        ASSERT_EQ(255, parse_int<int>("ff", 16).value);
+        ASSERT_EQ(-5, parse_int<int>("-101", 2).value);
+        ASSERT_EQ(35, parse_int<int>("Z", 36).value);
+        ASSERT_EQ(1, parse_int<int>("12", 2).consumed);
+        ASSERT_EQ(parse_errc::invalid, parse_int<int>("1", 37).error);
+    }
+
+    TEST(parse_number, int_random) {
+        std::mt19937_64 rng(7);
+        for(int i = 0; i < 20000; ++i) {
+            auto value = int64_t(rng()) >> (rng() % 64);
+            auto text = std::to_string(value);
+            auto r = parse_int<int64_t>(text + "|");
+            ASSERT_TRUE(bool(r)) << text;
+            ASSERT_EQ(value, r.value) << text;
+            ASSERT_EQ(text.size(), r.consumed);
+        }
+    }
+
+    TEST(parse_number, powers_of_five) {
+        auto&& powers = detail::powers_of_five::get();
+        ASSERT_EQ(0xeef453d6923bd65a, powers[-342][0]);
+        ASSERT_EQ(0x113faa2906a13b3f, powers[-342][1]);
+        ASSERT_EQ(0xfd87b5f28300ca0d, powers[-28][0]);
+        ASSERT_EQ(0x8bca9d6e188853fc, powers[-28][1]);
+        ASSERT_EQ(0x9e74d1b791e07e48, powers[-27][0]);
+        ASSERT_EQ(0x775ea264cf55347e, powers[-27][1]);
+        ASSERT_EQ(0xcccccccccccccccc, powers[-1][0]);
+        ASSERT_EQ(0xcccccccccccccccd, powers[-1][1]);
+        ASSERT_EQ(0x8000000000000000, powers[0][0]);
+        ASSERT_EQ(0, powers[0][1]);
+        ASSERT_EQ(0x813f3978f8940984, powers[28][0]);
+        ASSERT_EQ(0x4000000000000000, powers[28][1]);
+        ASSERT_EQ(0x8e679c2f5e44ff8f, powers[308][0]);
+        ASSERT_EQ(0x570f09eaa7ea7648, powers[308][1]);
+    }
+
+    void expect_double(const std::string& text) {
+        char* end = nullptr;
+        auto expected = std::strtod(text.c_str(), &end);
+        auto r = parse_float<double>(text);
+        ASSERT_EQ(size_t(end - text.c_str()), r.consumed) << text;
+        if(std::isnan(expected)) ASSERT_TRUE(std::isnan(r.value)) << text;
+        else ASSERT_EQ(expected, r.value) << text;
+        ASSERT_EQ(std::signbit(expected), std::signbit(r.value)) << text;
+    }
+
+    void expect_float(const std::string& text) {
+        auto expected = std::strtof(text.c_str(), nullptr);
+        ASSERT_EQ(expected, parse_float<float>(text).value) << text;
+    }
+
+    TEST(parse_number, float) {
+        for(auto text : { "0", "-0", "1", "1.5", ".5", "5.", "3.14159", "1e10", "1E-5", "-2.5e+3", "123456789012345678",
+                "1.7976931348623157e308", "2.2250738585072014e-308", "4.9406564584124654e-324", "2.4e-324",
+                "9007199254740993", "1e23", "8.98846567431158e307", "0.1", "0.000001234", "1e", "1e+", "2.e3x",
+                "7.2057594037927933e16", "179769313486231580793728971405303415079934132710037826936173778980444968292764750946649017977587207096330286416692887910946555547851940402630657488671505820681908902000708383676273854845817711531764475730270069855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497791.9999999999999999999999999999999999999999999999999999999999999999999999",
+                "2.225073858507201136057409796709131975934819546351645648023426109724822222021076945516529523908135087914149158913039621106870086438694594645527657207407820621743379988141063267329253552286881372149012981122451451889849057222307285255133155755015914397476397983411801999323962548289017107081850690630666655994938275772572015763062690663332647565300009245888316433037779791869612049497390377829704905051080609940730262937128958950003583799967207254304360284078895771796150945516748243471030702609144621572289880258182545180325707018860872113128079512233426288368622321503775666622503982534335974568884423900265498198385487948292206894721689831099698365846814022854243330660339850886445804001034933970427567186443383770486037861622771738545623065874679014086723327636718749999999999999999999999999999999999999e-308",
+                "inf", "-Infinity", "INFx", "nan", "-nan(0x1f)", "nan(", "1.0000000000000000000000001", "00000.000000000000000000000000000000000000000000001" })
+            expect_double(text);
+        ASSERT_EQ(parse_errc::invalid, parse_float<double>("").error);
+        ASSERT_EQ(parse_errc::invalid, parse_float<double>(".").error);
+        ASSERT_EQ(parse_errc::invalid, parse_float<double>("+1").error);
+        ASSERT_EQ(parse_errc::invalid, parse_float<double>("e5").error);
+        ASSERT_EQ(parse_errc::out_of_range, parse_float<double>("1e400").error);
+        ASSERT_EQ(parse_errc::out_of_range, parse_float<double>("-1e-400").error);
+        ASSERT_TRUE(std::signbit(parse_float<double>("-1e-400").value));
+        ASSERT_EQ(parse_errc::ok, parse_float<double>("0e999999999").error);
+
+        for(auto text : { "1", "0.1", "3.4028234e38", "1.17549435e-38", "1e-45", "16777217", "1e10", "3.14159265358979" })
+            expect_float(text);
+        ASSERT_EQ(parse_errc::out_of_range, parse_float<float>("1e39").error);
+    }
+
+    TEST(parse_number, float_random) {
+        std::mt19937_64 rng(11);
+        char buffer[64];
+        for(int i = 0; i < 20000; ++i) {
+            uint64_t bits = rng();
+            double value;
+            std::memcpy(&value, &bits, 8);
+            if(!std::isfinite(value)) continue;
+            // shortest forms, long forms, and truncated ones that land between doubles
+            snprintf(buffer, sizeof(buffer), "%.17g", value);
+            expect_double(buffer);
+            snprintf(buffer, sizeof(buffer), "%.*g", int(rng() % 25) + 1, value);
+            expect_double(buffer);
+            snprintf(buffer, sizeof(buffer), "%.9g", double(float(value)));
+            expect_float(buffer);
+        }
+        for(int i = 0; i < 20000; ++i) {
+            std::string text = std::to_string(rng() % 100000) + "." + std::to_string(rng()) + std::to_string(rng());
+            expect_double(text);
+            expect_double(text + "e-" + std::to_string(rng() % 320));
+            expect_double(text + "e" + std::to_string(rng() % 300));
+        }
+    }
+
+    TEST(parse_number, delimited) {
+        std::vector<double> values;
+        auto r = parse_delimited<double>("1.5,2,-3e2\n4", ',', std::back_inserter(values));
+        ASSERT_EQ(3, r.count);
+        ASSERT_EQ(10, r.consumed);
+        ASSERT_EQ(parse_errc::ok, r.error);
+        ASSERT_EQ((std::vector<double>{ 1.5, 2, -300 }), values);
+
+        std::vector<int> ints;
+        r = parse_delimited<int>("1|2||4", '|', std::back_inserter(ints));
+        ASSERT_EQ(2, r.count);
+        ASSERT_EQ(3, r.consumed);
+        ASSERT_EQ(parse_errc::invalid, r.error);
+
+        int fixed[2];
+        r = parse_delimited<int>("7,8,9", ',', fixed, 2);
+        ASSERT_EQ(2, r.count);
+        ASSERT_EQ(3, r.consumed);
+        ASSERT_EQ(8, fixed[1]);
+
+        ints.clear();
+        r = parse_delimited<int>("5", ',', std::back_inserter(ints));
+        ASSERT_EQ(1, r.count);
+        ASSERT_EQ(1, r.consumed);
+    }
+}
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "prefix_index.hpp"
+
+namespace {
+    using namespace essentials;
+
+    TEST(prefix_index, longest_prefix) {
+        prefix_index<int> routes{
+            { "/", 0 }, { "/api", 1 }, { "/api/v1", 2 }, { "/api/v2", 3 }, { "/apix", 4 }, { "/static/", 5 },
+        };
+        ASSERT_EQ(6U, routes.size());
+        ASSERT_EQ(2, routes.longest_prefix("/api/v1/users")->second);
+        ASSERT_EQ("/api/v1"_sv, routes.longest_prefix("/api/v1/users")->first);
+        ASSERT_EQ(1, routes.longest_prefix("/api/v3")->second);
+        ASSERT_EQ(1, routes.longest_prefix("/api")->second);
+        ASSERT_EQ(0, routes.longest_prefix("/ap")->second);
+        ASSERT_EQ(4, routes.longest_prefix("/apixyz")->second);
+        ASSERT_EQ(0, routes.longest_prefix("/static")->second);
+        ASSERT_EQ(nullptr, routes.longest_prefix("api"));
+        ASSERT_EQ(nullptr, routes.longest_prefix(""));
+
+        auto all = routes.all_prefixes("/api/v2/x");
+        ASSERT_EQ(3U, all.size());
+        ASSERT_EQ("/"_sv, all[0]->first);
+        ASSERT_EQ("/api"_sv, all[1]->first);
+        ASSERT_EQ("/api/v2"_sv, all[2]->first);
+    }
+
+    TEST(prefix_index, with_prefix) {
+        prefix_index<int> index{ { "car", 1 }, { "cart", 2 }, { "carbon", 3 }, { "cat", 4 }, { "dog", 5 }, { "", 6 } };
+        std::vector<std::string> keys;
+        for(auto&& item : index.with_prefix("car")) keys.emplace_back(item.first);
+        ASSERT_EQ((std::vector<std::string>{ "car", "carbon", "cart" }), keys);
+        ASSERT_EQ(4U, index.with_prefix("ca").size());
+        ASSERT_EQ(1U, index.with_prefix("carb").size());
+        ASSERT_EQ(6U, index.with_prefix("").size());
+        ASSERT_TRUE(index.with_prefix("cab").empty());
+        ASSERT_TRUE(index.with_prefix("carts").empty());
+
+        ASSERT_EQ(3, index.find("carbon")->second);
+        ASSERT_EQ(6, index.find("")->second);
+        ASSERT_EQ(nullptr, index.find("carb"));
+        ASSERT_EQ(6, index.longest_prefix("xyz")->second);
+    }
+
+    TEST(prefix_index, ownership) {
+        std::vector<std::pair<std::string, int>> config{ { "b", 2 }, { "a", 1 }, { "a", 10 }, { "ab", 3 } };
+        prefix_index<int> index(config.begin(), config.end());
+        config.clear();
+        // duplicates keep the first
+        ASSERT_EQ(3U, index.size());
+        ASSERT_EQ(1, index.find("a")->second);
+
+        // short key pools move with the object
+        auto moved = std::move(index);
+        prefix_index<int> copy;
+        copy = moved;
+        ASSERT_EQ(3, moved.longest_prefix("abc")->second);
+        ASSERT_EQ(3, copy.longest_prefix("abc")->second);
+        ASSERT_EQ("ab"_sv, copy.longest_prefix("abc")->first);
+        ASSERT_TRUE(prefix_index<int>().empty());
+        ASSERT_EQ(nullptr, prefix_index<int>().longest_prefix("a"));
+    }
+
+    TEST(prefix_index, deep_nesting) {
+        // "a", "aa", "aaa", ...: one trie level per key
+        std::vector<std::pair<std::string, size_t>> items;
+        for(size_t ix = 1; ix <= 20000; ++ix) items.emplace_back(std::string(ix, 'a'), ix);
+        prefix_index<size_t> index(items.begin(), items.end());
+        ASSERT_EQ(20000U, index.size());
+        ASSERT_EQ(20000U, index.longest_prefix(std::string(30000, 'a'))->second);
+        ASSERT_EQ(777U, index.longest_prefix(std::string(777, 'a') + "b")->second);
+        ASSERT_EQ(500U, index.with_prefix(std::string(19501, 'a')).size());
+    }
+
+    TEST(prefix_index, against_scan) {
+        std::mt19937 rng{ 7U };
+        auto random_key = [&](size_t max) {
+            std::string res(rng() % max, 'a');
+            for(auto&& c : res) c = char('a' + rng() % 3);
+            return res;
+        };
+        std::vector<std::pair<std::string, size_t>> items;
+        for(size_t ix = 0; ix < 300; ++ix) items.emplace_back(random_key(8), ix);
+        prefix_index<size_t> index(items.begin(), items.end());
+
+        for(size_t round = 0; round < 2000; ++round) {
+            auto query = random_key(12);
+            const std::pair<std::string, size_t>* expected = nullptr;
+            size_t count = 0, below = 0;
+            std::vector<std::string> seen;
+            for(auto&& item : items) {
+                if(std::find(seen.begin(), seen.end(), item.first) != seen.end()) continue;
+                seen.push_back(item.first);
+                if(query.compare(0, item.first.size(), item.first) == 0 && item.first.size() <= query.size()) {
+                    ++count;
+                    if(!expected || expected->first.size() < item.first.size()) expected = &item;
+                }
+                if(item.first.compare(0, query.size(), query) == 0 && item.first.size() >= query.size()) ++below;
+            }
+            auto found = index.longest_prefix(query);
+            ASSERT_EQ(expected == nullptr, found == nullptr);
+            if(found) {
+                ASSERT_EQ(expected->second, found->second);
+            }
+            ASSERT_EQ(count, index.all_prefixes(query).size());
+            ASSERT_EQ(below, index.with_prefix(query).size());
+        }
+    }
+}
@@ -0,0 +1,154 @@
+#include <random>
+
+#include <gtest/gtest.h>
+#include "string_view.hpp"
+
+namespace {
+    using namespace essentials;
+
+    std::string random_string(std::mt19937& rng, size_t size, char alphabet) {
+        std::uniform_int_distribution<int> dist('a', alphabet);
+        std::string res(size, 'a');
+        for(auto&& c : res) c = char(dist(rng));
+        return res;
+    }
+
+    TEST(search, find_matches_std_string) {
+        std::mt19937 rng(42);
+        for(char alphabet : { 'a', 'b', 'd', 'z' }) {
+            for(int iteration = 0; iteration < 400; ++iteration) {
+                auto hay = random_string(rng, rng() % 300, alphabet);
+                auto needle_size = 1 + rng() % 100;
+                std::string needle;
+                if(rng() % 2 && needle_size <= hay.size()) {
+                    needle = hay.substr(rng() % (hay.size() - needle_size + 1), needle_size);
+                } else {
+                    needle = random_string(rng, needle_size, alphabet);
+                }
+                string_view vh = hay;
+                for(size_t pos : { size_t(0), size_t(1), hay.size() / 2 }) {
+                    if(pos >= hay.size()) continue;
+                    ASSERT_EQ(hay.find(needle, pos), vh.find(needle, pos)) << hay << " / " << needle << " @" << pos;
+                }
+            }
+        }
+    }
+
+    TEST(search, find_long_needles) {
+        std::string hay(5000, 'a');
+        std::string needle(200, 'a');
+        needle.back() = 'b';
+        string_view vh = hay;
+        ASSERT_EQ(string_view::npos, vh.find(needle));
+        hay.replace(4000, needle.size(), needle);
+        vh = hay;
+        ASSERT_EQ(hay.find(needle), vh.find(needle));
+        ASSERT_EQ(hay.find(needle, 3999), vh.find(needle, 3999));
+        ASSERT_EQ(string_view::npos, vh.find(needle, 4001));
+
+        std::string periodic;
+        for(int i = 0; i < 100; ++i) periodic += "abcab";
+        std::string text = periodic.substr(0, 300) + "x" + periodic + "abc";
+        ASSERT_EQ(text.find(periodic), string_view(text).find(periodic));
+    }
+
+    TEST(search, find_edges) {
+        ASSERT_EQ(string_view::npos, string_view("abc").find("abc", 3));
+        ASSERT_EQ(string_view::npos, string_view("abc").find("", 3));
+        ASSERT_EQ(0, string_view("abc").find("abc"));
+        ASSERT_EQ(string_view::npos, string_view("abc").find("abcd"));
+        ASSERT_EQ(1, string_view("a\0b\0c", 5).find(string_view("\0b", 2)));
+
+        std::wstring ws = L"hello world, hello again";
+        wstring_view wv = ws;
+        ASSERT_EQ(ws.find(L"hello", 1), wv.find(L"hello", 1));
+        ASSERT_EQ(ws.find(L"lo wo"), wv.find(L"lo wo"));
+    }
+
+    TEST(search, find_of_matches_std_string) {
+        std::mt19937 rng(7);
+        for(int iteration = 0; iteration < 2000; ++iteration) {
+            auto hay = random_string(rng, rng() % 200, 'a' + char(rng() % 26));
+            if(!hay.empty() && rng() % 4 == 0) hay[rng() % hay.size()] = char(0x80 + rng() % 128);
+            auto set = random_string(rng, rng() % 6, 'z');
+            if(rng() % 3 == 0) set += char(0x80 + rng() % 128);
+            string_view vh = hay;
+            char_set cs = string_view(set);
+            for(size_t pos : { size_t(0), size_t(rng() % 250), std::string::npos }) {
+                ASSERT_EQ(hay.find_first_of(set, pos), vh.find_first_of(set, pos)) << hay << " / " << set << " @" << pos;
+                ASSERT_EQ(hay.find_last_of(set, pos), vh.find_last_of(set, pos)) << hay << " / " << set << " @" << pos;
+                ASSERT_EQ(hay.find_first_not_of(set, pos), vh.find_first_not_of(set, pos)) << hay << " / " << set << " @" << pos;
+                ASSERT_EQ(hay.find_last_not_of(set, pos), vh.find_last_not_of(set, pos)) << hay << " / " << set << " @" << pos;
+                ASSERT_EQ(vh.find_first_of(set, pos), vh.find_first_of(cs, pos));
+                ASSERT_EQ(vh.find_last_of(set, pos), vh.find_last_of(cs, pos));
+                ASSERT_EQ(vh.find_first_not_of(set, pos), vh.find_first_not_of(cs, pos));
+                ASSERT_EQ(vh.find_last_not_of(set, pos), vh.find_last_not_of(cs, pos));
+            }
+        }
+    }
+
+    TEST(search, char_set) {
+        char_set ws = " \t\r\n,;";
+        ASSERT_TRUE(ws.contains(' '));
+        ASSERT_TRUE(ws.contains(';'));
+        ASSERT_FALSE(ws.contains('a'));
+        ASSERT_FALSE(ws.contains('\0'));
+        ASSERT_TRUE(char_set(string_view("\xff\x80", 2)).contains('\xff'));
+
+        std::string line = "  alpha, beta;\tgamma  ";
+        string_view vl = line;
+        ASSERT_EQ(line.find_first_not_of(" \t\r\n,;"), vl.find_first_not_of(ws));
+        ASSERT_EQ(line.find_last_not_of(" \t\r\n,;"), vl.find_last_not_of(ws));
+        ASSERT_EQ(line.find_first_of(" \t\r\n,;", 3), vl.find_first_of(ws, 3));
+
+        std::wstring wide = L"key = value; other = thing";
+        std::wstring wset = L"=;тест 0123456789";
+        wstring_view wv = wide;
+        wchar_set wcs = wstring_view(wset);
+        ASSERT_TRUE(wcs.contains(L'т'));
+        ASSERT_FALSE(wcs.contains(L'k'));
+        ASSERT_EQ(wide.find_first_of(wset), wv.find_first_of(wcs));
+        ASSERT_EQ(wide.find_first_of(wset, 5), wv.find_first_of(wset, 5));
+        ASSERT_EQ(wide.find_last_of(wset), wv.find_last_of(wset));
+        ASSERT_EQ(wide.find_first_not_of(wset, 3), wv.find_first_not_of(wset, 3));
+        ASSERT_EQ(wide.find_last_not_of(wset), wv.find_last_not_of(wset));
+    }
+
+    TEST(search, rfind_matches_std_string) {
+        std::mt19937 rng(1337);
+        for(char alphabet : { 'a', 'b', 'd', 'z' }) {
+            for(int iteration = 0; iteration < 400; ++iteration) {
+                auto hay = random_string(rng, rng() % 300, alphabet);
+                auto needle_size = 1 + rng() % 100;
+                std::string needle;
+                if(rng() % 2 && needle_size <= hay.size()) {
+                    needle = hay.substr(rng() % (hay.size() - needle_size + 1), needle_size);
+                } else {
+                    needle = random_string(rng, needle_size, alphabet);
+                }
+                string_view vh = hay;
+                for(size_t pos : { std::string::npos, size_t(0), hay.size() / 2, size_t(rng() % 320) }) {
+                    ASSERT_EQ(hay.rfind(needle, pos), vh.rfind(needle, pos)) << hay << " / " << needle << " @" << pos;
+                    ASSERT_EQ(hay.rfind(needle[0], pos), vh.rfind(needle[0], pos)) << hay << " / " << needle[0] << " @" << pos;
+                }
+            }
+        }
+
+        std::string hay(5000, 'a');
+        std::string needle(200, 'a');
+        needle.front() = 'b';
+        ASSERT_EQ(string_view::npos, string_view(hay).rfind(needle));
+        hay.replace(100, needle.size(), needle);
+        ASSERT_EQ(hay.rfind(needle), string_view(hay).rfind(needle));
+        ASSERT_EQ(hay.rfind(needle, 100), string_view(hay).rfind(needle, 100));
+        ASSERT_EQ(string_view::npos, string_view(hay).rfind(needle, 99));
+        ASSERT_EQ(2, string_view("aaaa").rfind("aa"));
+
+        std::wstring ws = L"hello world, hello again";
+        wstring_view wv = ws;
+        ASSERT_EQ(ws.rfind(L"hello"), wv.rfind(L"hello"));
+        ASSERT_EQ(ws.rfind(L"hello", 12), wv.rfind(L"hello", 12));
+        ASSERT_EQ(ws.rfind(L'o', 8), wv.rfind(L'o', 8));
+    }
+
+}
@@ -0,0 +1,54 @@
+#include <random>
+
+#include <gtest/gtest.h>
+#include "searcher.hpp"
+
+namespace {
+    using namespace essentials;
+
+    std::string random_string(std::mt19937& rng, size_t size, char alphabet) {
+        std::uniform_int_distribution<int> dist('a', alphabet);
+        std::string res(size, 'a');
+        for(auto&& c : res) c = char(dist(rng));
+        return res;
+    }
+
+    TEST(searcher, matches_find) {
+        std::mt19937 rng(99);
+        for(size_t needle_size : { 1, 2, 7, 64, 65, 150, 256, 257, 600 }) {
+            for(char alphabet : { 'b', 'd', 'z' }) {
+                for(int iteration = 0; iteration < 40; ++iteration) {
+                    auto hay = random_string(rng, 2000, alphabet);
+                    auto needle = (iteration % 2)?
+                        hay.substr(rng() % (hay.size() - needle_size), needle_size) :
+                        random_string(rng, needle_size, alphabet);
+                    searcher s(needle);
+                    string_view vh = hay;
+                    for(size_t pos : { size_t(0), size_t(1), size_t(rng() % 2000), size_t(1999), size_t(2000) }) {
+                        ASSERT_EQ(vh.find(needle, pos), s(vh, pos)) << needle_size << " @" << pos;
+                        ASSERT_EQ(vh.find(needle, pos), vh.find(s, pos)) << needle_size << " @" << pos;
+                    }
+                }
+            }
+        }
+    }
+
+    TEST(searcher, reuse) {
+        searcher s("\"status\"");
+        ASSERT_EQ(1, string_view("{\"status\":1}").find(s));
+        ASSERT_EQ(string_view::npos, string_view("{\"stat\":1}").find(s));
+        ASSERT_EQ(string_view::npos, string_view("{\"status\":1}").find(s, 2));
+        ASSERT_EQ("\"status\""_sv, s.needle());
+
+        searcher empty(""_sv);
+        ASSERT_EQ(3, string_view("abcdef").find(empty, 3));
+        ASSERT_EQ(string_view::npos, string_view("abc").find(empty, 3));
+
+        std::wstring wneedle(100, L'ж');
+        std::wstring whay = L"prefix" + wneedle + L"suffix";
+        wsearcher ws(wneedle);
+        ASSERT_EQ(6, wstring_view(whay).find(ws));
+        ASSERT_EQ(whay.find(wneedle, 7), wstring_view(whay).find(ws, 7));
+    }
+
+}
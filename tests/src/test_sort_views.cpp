@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "sort_views.hpp"
+
+namespace {
+    using namespace essentials;
+
+    // keys sharing long prefixes, with embedded zeros, high bytes and plenty of duplicates
+    std::vector<std::string> make_keys(size_t count, std::mt19937& rng) {
+        static const std::string prefixes[] = { "", "http://example.com/", std::string("a\0b", 3), "\xff\xfe", "aaaaaaaaaaaaaaaaaaaaaaaaaa" };
+        std::vector<std::string> res;
+        for(size_t ix = 0; ix < count; ++ix) {
+            auto key = prefixes[rng() % 5];
+            auto extra = rng() % 20;
+            for(size_t c = 0; c < extra; ++c) key += char("\0\x01" "ab\x7f\x80\xff"[rng() % 7]);
+            res.push_back(key);
+        }
+        return res;
+    }
+
+    void check_sort(size_t count, unsigned threads) {
+        std::mt19937 rng(unsigned(count + threads));
+        auto keys = make_keys(count, rng);
+        std::vector<string_view> views(keys.begin(), keys.end());
+        auto expected = views;
+        std::stable_sort(expected.begin(), expected.end());
+
+        auto sorted = views;
+        sort_views(sorted.begin(), sorted.end(), threads);
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), sorted.begin()));
+
+        // stable: the very same views, pointers included
+        auto stable = views;
+        stable_sort_views(stable.begin(), stable.end(), threads);
+        for(size_t ix = 0; ix < stable.size(); ++ix) ASSERT_EQ(expected[ix].data(), stable[ix].data());
+
+        auto unique = views;
+        unique.erase(unique_views(unique.begin(), unique.end(), threads), unique.end());
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+        ASSERT_EQ(expected.size(), unique.size());
+        for(size_t ix = 0; ix < unique.size(); ++ix) ASSERT_EQ(expected[ix].data(), unique[ix].data());
+    }
+
+    TEST(sort_views, small) {
+        for(size_t count : { 0, 1, 2, 10, 65, 1000 }) check_sort(count, 1);
+    }
+
+    TEST(sort_views, parallel) {
+        check_sort(200000, 1);
+        check_sort(200000, 4);
+    }
+
+    TEST(sort_views, fallback) {
+        std::vector<std::wstring> keys{ L"b", L"a", L"ab", L"", L"a" };
+        std::vector<wstring_view> views(keys.begin(), keys.end());
+        sort_views(views.begin(), views.end());
+        ASSERT_TRUE(std::is_sorted(views.begin(), views.end()));
+        ASSERT_EQ(4, unique_views(views.begin(), views.end()) - views.begin());
+    }
+
+}
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "split.hpp"
+
+namespace {
+    using namespace essentials;
+
+    template<class Range>
+    std::vector<std::string> collect(const Range& range) {
+        std::vector<std::string> res;
+        for(auto field : range) res.push_back(field);
+        return res;
+    }
+
+    using fields = std::vector<std::string>;
+
+    TEST(split, single_char) {
+        ASSERT_EQ(fields({ "a", "b", "", "c" }), collect(split("a,b,,c"_sv, ',')));
+        ASSERT_EQ(fields({ "" }), collect(split(""_sv, ',')));
+        ASSERT_EQ(fields({ "", "" }), collect(split(","_sv, ',')));
+        ASSERT_EQ(fields({ "abc" }), collect(split("abc"_sv, ',')));
+        ASSERT_EQ(fields({ "a", "" }), collect(split("a,"_sv, ',')));
+    }
+
+    TEST(split, multi_char) {
+        ASSERT_EQ(fields({ "a", "b", "c" }), collect(split("a::b::c"_sv, "::")));
+        ASSERT_EQ(fields({ "a", ":b" }), collect(split("a:::b"_sv, "::")));
+        ASSERT_EQ(fields({ "header", "", "body" }), collect(split("header\r\n\r\nbody"_sv, "\r\n"_sv)));
+        ASSERT_EQ(fields({ "abc" }), collect(split("abc"_sv, ""_sv)));
+    }
+
+    TEST(split, char_set) {
+        char_set ws = " \t,;";
+        ASSERT_EQ(fields({ "a", "b", "", "c", "" }), collect(split("a b\t;c,"_sv, ws)));
+        ASSERT_EQ(fields({ "a", "b", "c" }), collect(split(" a b\t;c,"_sv, ws, split_mode::skip_empty)));
+    }
+
+    TEST(split, skip_empty_and_max_splits) {
+        ASSERT_EQ(fields({ "a", "b", "c" }), collect(split(",,a,,b,c,"_sv, ',', split_mode::skip_empty)));
+        ASSERT_EQ(fields({}), collect(split(",,,"_sv, ',', split_mode::skip_empty)));
+        ASSERT_EQ(fields({}), collect(split(""_sv, ',', split_mode::skip_empty)));
+        ASSERT_EQ(fields({ "a", "b,c,d" }), collect(split("a,b,c,d"_sv, ',', split_mode::keep_empty, 1)));
+        ASSERT_EQ(fields({ "a,b,c,d" }), collect(split("a,b,c,d"_sv, ',', split_mode::keep_empty, 0)));
+        ASSERT_EQ(fields({ "a", "b", ",c" }), collect(split(",a,,b,,c"_sv, ',', split_mode::skip_empty, 2)));
+        ASSERT_EQ(fields({ "GET", "/index.html HTTP/1.1" }), collect(split("GET /index.html HTTP/1.1"_sv, ' ', split_mode::keep_empty, 1)));
+    }
+
+    TEST(split, algorithms) {
+        auto range = split("x=1;y=22;z=333"_sv, ';');
+        ASSERT_EQ(3, std::distance(range.begin(), range.end()));
+        auto found = std::find(range.begin(), range.end(), "y=22"_sv);
+        ASSERT_NE(range.end(), found);
+        ASSERT_EQ("y=22"_sv, *found);
+        ASSERT_EQ(4, found->size());
+        auto longest = std::max_element(range.begin(), range.end(),
+            [](string_view lhv, string_view rhv) { return lhv.size() < rhv.size(); });
+        ASSERT_EQ("z=333"_sv, *longest);
+
+        auto it = range.begin();
+        auto copy = it++;
+        ASSERT_EQ("x=1"_sv, *copy);
+        ASSERT_EQ("y=22"_sv, *it);
+        ASSERT_NE(copy, it);
+        ASSERT_EQ(range.begin(), copy);
+    }
+
+    TEST(split, fields_are_views) {
+        std::string line = "alpha beta";
+        auto range = split(string_view(line), ' ');
+        auto first = *range.begin();
+        ASSERT_EQ(line.data(), first.data());
+        ASSERT_EQ(line.data() + 6, (*++range.begin()).data());
+    }
+
+    TEST(split, wide) {
+        std::vector<std::wstring> res;
+        for(auto field : split(wstring_view(L"один, два, три"), L", ")) res.push_back(field);
+        ASSERT_EQ(std::vector<std::wstring>({ L"один", L"два", L"три" }), res);
+    }
+
+}
@@ -0,0 +1,67 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "static_string_map.hpp"
+
+namespace {
+    using namespace essentials;
+
+    enum class method { get, put, post, head, del, options };
+
+    constexpr auto methods = make_static_string_map<method>({
+        { "GET"_sv, method::get },
+        { "PUT"_sv, method::put },
+        { "POST"_sv, method::post },
+        { "HEAD"_sv, method::head },
+        { "DELETE"_sv, method::del },
+        { "OPTIONS"_sv, method::options },
+    });
+
+    static_assert(methods.size() == 6, "size is a constant");
+    static_assert(methods.at("POST"_sv) == method::post, "lookups run at compile time");
+    static_assert(methods.get("PATCH"_sv, method::get) == method::get, "missing keys fall back");
+    static_assert(!methods.contains("get"_sv), "keys are case-sensitive");
+    static_assert(methods.index("DELETE"_sv) == 4, "index is the position in the list");
+
+    int dispatch(string_view command) {
+        switch(methods.index(command)) {
+        case methods.index("GET"_sv): return 1;
+        case methods.index("HEAD"_sv): return 2;
+        default: return 0;
+        }
+    }
+
+    TEST(static_string_map, lookup) {
+        std::string get = "GET", options = "OPTIONS";
+        ASSERT_EQ(method::get, *methods.find(get));
+        ASSERT_EQ(method::options, methods.at(options));
+        ASSERT_EQ(nullptr, methods.find("PATCH"));
+        ASSERT_EQ(nullptr, methods.find(""));
+        ASSERT_EQ(nullptr, methods.find("GETX"));
+        ASSERT_THROW(methods.at("TRACE"), std::out_of_range);
+        ASSERT_EQ(string_view("HEAD"), methods.key(3));
+
+        ASSERT_EQ(1, dispatch(get));
+        ASSERT_EQ(2, dispatch("HEAD"));
+        ASSERT_EQ(0, dispatch("PUT"));
+        ASSERT_EQ(0, dispatch("BREW"));
+    }
+
+    TEST(static_string_map, many_keys) {
+        std::vector<std::string> names;
+        for(int i = 0; i < 300; ++i) names.push_back("header-" + std::to_string(i * 7919));
+        std::pair<string_view, int> items[300];
+        for(int i = 0; i < 300; ++i) items[i] = { names[size_t(i)], i };
+        static_string_map<int, 300> map(items);
+        for(int i = 0; i < 300; ++i) ASSERT_EQ(i, map.at(names[size_t(i)]));
+        ASSERT_FALSE(map.contains("header-1"));
+        ASSERT_FALSE(map.contains("header-"));
+    }
+
+    TEST(static_string_map, duplicates) {
+        std::pair<string_view, int> items[] = { { "a", 1 }, { "b", 2 }, { "a", 3 } };
+        ASSERT_THROW((static_string_map<int, 3>(items)), std::invalid_argument);
+    }
+}
@@ -0,0 +1,71 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "stream_searcher.hpp"
+
+namespace {
+    using namespace essentials;
+
+    std::string random_string(std::mt19937& rng, size_t size, char alphabet) {
+        std::uniform_int_distribution<int> dist('a', alphabet);
+        std::string res(size, 'a');
+        for(auto&& c : res) c = char(dist(rng));
+        return res;
+    }
+
+    // every occurrence, overlapping ones included
+    std::vector<size_t> all_matches(string_view hay, string_view needle) {
+        std::vector<size_t> res;
+        for(auto pos = hay.find(needle); pos != string_view::npos; pos = hay.find(needle, pos + 1)) res.push_back(pos);
+        return res;
+    }
+
+    TEST(stream_searcher, across_chunks) {
+        stream_searcher s("boundary");
+        std::vector<size_t> found;
+        for(auto chunk : { "--bou"_sv, "nd"_sv, "ary\r\n--b"_sv, "oundary--"_sv, "boundary"_sv })
+            s.feed(chunk, [&](size_t offset) { found.push_back(offset); });
+        ASSERT_EQ((std::vector<size_t>{ 2, 14, 24 }), found);
+        ASSERT_EQ(32U, s.offset());
+        ASSERT_EQ(0U, s.pending());
+
+        ASSERT_EQ(std::vector<size_t>{}, s.feed("xxbound"));
+        ASSERT_EQ(5U, s.pending());
+        s.reset();
+        ASSERT_EQ(std::vector<size_t>{}, s.feed("ary"));
+    }
+
+    TEST(stream_searcher, overlapping) {
+        stream_searcher s("aaa");
+        std::vector<size_t> found;
+        for(auto chunk : { "a"_sv, "aa"_sv, "aa"_sv, "ba"_sv, "aaa"_sv })
+            s.feed(chunk, [&](size_t offset) { found.push_back(offset); });
+        ASSERT_EQ((std::vector<size_t>{ 0, 1, 2, 6, 7 }), found);
+        ASSERT_EQ(std::vector<size_t>{}, stream_searcher("").feed("abc"));
+    }
+
+    TEST(stream_searcher, matches_find) {
+        std::mt19937 rng{ 5U };
+        for(size_t needle_size : { 1, 2, 5, 17, 64, 65, 300 }) {
+            for(char alphabet : { 'b', 'c', 'z' }) {
+                for(int iteration = 0; iteration < 20; ++iteration) {
+                    auto hay = random_string(rng, 3000, alphabet);
+                    auto needle = (iteration % 2)?
+                        hay.substr(rng() % (hay.size() - needle_size), needle_size) :
+                        random_string(rng, needle_size, alphabet);
+                    stream_searcher s(needle);
+                    std::vector<size_t> found;
+                    for(size_t pos = 0; pos < hay.size();) {
+                        // chunks around the needle size hit every boundary case
+                        auto size = std::min<size_t>(hay.size() - pos, rng() % (2 * needle_size + 2));
+                        s.feed(string_view(hay).substr(pos, size), [&](size_t offset) { found.push_back(offset); });
+                        pos += size;
+                    }
+                    ASSERT_EQ(all_matches(hay, needle), found) << needle_size << " " << alphabet;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "string_arena.hpp"
+
+namespace {
+    using namespace essentials;
+
+    TEST(string_arena, store) {
+        string_arena arena(64);
+        std::vector<string_view> stored;
+        std::vector<std::string> expected;
+        for(int i = 0; i < 1000; ++i) {
+            expected.push_back("key_" + std::to_string(i));
+            std::string temporary = expected.back();
+            stored.push_back(arena.store(temporary));
+        }
+        for(size_t i = 0; i < stored.size(); ++i) ASSERT_EQ(expected[i], stored[i]);
+
+        auto big = std::string(100, 'x');
+        auto v = arena.store(big);
+        ASSERT_EQ(big, v);
+        ASSERT_NE(big.data(), v.data());
+        ASSERT_TRUE(arena.store("").empty());
+
+        auto stats = arena.stats();
+        ASSERT_EQ(1001, stats.allocations);
+        ASSERT_EQ(1, stats.large_blocks);
+        ASSERT_GE(stats.reserved, stats.used);
+        ASSERT_EQ(stats.used, stats.peak);
+    }
+
+    TEST(string_arena, rewind) {
+        string_arena arena(64);
+        auto kept = arena.store("kept");
+        auto mark = arena.position();
+        auto first = arena.store("dropped");
+        for(int i = 0; i < 100; ++i) arena.store("filler_filler");
+        arena.store(std::string(1000, 'y'));
+        auto before = arena.stats();
+        arena.rewind(mark);
+
+        auto after = arena.stats();
+        ASSERT_EQ(4, after.used);
+        ASSERT_EQ(0, after.large_blocks);
+        ASSERT_EQ(before.chunks, after.chunks);
+        ASSERT_EQ(before.peak, after.peak);
+        ASSERT_EQ("kept", kept);
+        // the space is reused from the mark on
+        ASSERT_EQ(first.data(), arena.store("again").data());
+
+        for(int i = 0; i < 100; ++i) arena.store("filler_filler");
+        ASSERT_EQ(before.chunks, arena.stats().chunks);
+
+        arena.reset();
+        ASSERT_EQ(0, arena.stats().used);
+        ASSERT_EQ(before.chunks, arena.stats().chunks);
+        ASSERT_EQ(kept.data(), arena.store("kept").data());
+        arena.release();
+        ASSERT_EQ(0, arena.stats().chunks);
+        ASSERT_EQ(0, arena.stats().reserved);
+    }
+
+    TEST(string_arena, scope) {
+        string_arena arena;
+        arena.store("outer");
+        {
+            string_arena::scope request(arena);
+            arena.store("inner");
+            ASSERT_EQ(10, arena.stats().used);
+        }
+        ASSERT_EQ(5, arena.stats().used);
+    }
+
+    TEST(string_arena, local) {
+        auto&& mine = string_arena::local();
+        ASSERT_EQ(&mine, &string_arena::local());
+        const string_arena* theirs = nullptr;
+        std::thread([&theirs] { theirs = &string_arena::local(); }).join();
+        ASSERT_NE(&mine, theirs);
+    }
+
+    TEST(string_arena, wide) {
+        wstring_arena arena(16);
+        auto v = arena.store(L"wide string");
+        ASSERT_EQ(wstring_view(L"wide string"), v);
+    }
+}
@@ -0,0 +1,153 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "utf8.hpp"
+
+namespace {
+    using namespace essentials;
+
+    size_t scalar_invalid(const std::string& s) {
+        auto res = detail::utf8_find_invalid_scalar(reinterpret_cast<const unsigned char*>(s.data()), s.size(), 0);
+        return (res == size_t(-1))? string_view::npos : res;
+    }
+
+    // random text mixing every sequence length
+    std::string random_utf8(std::mt19937& rng, size_t count) {
+        std::string res;
+        char buffer[4];
+        for(size_t i = 0; i < count; ++i) {
+            char32_t cp;
+            switch(rng() % 4) {
+            case 0: cp = rng() % 0x80; break;
+            case 1: cp = 0x80 + rng() % (0x800 - 0x80); break;
+            case 2: cp = 0x800 + rng() % (0x10000 - 0x800); if(cp >= 0xD800 && cp <= 0xDFFF) cp = 'x'; break;
+            default: cp = 0x10000 + rng() % (0x110000 - 0x10000); break;
+            }
+            res.append(buffer, detail::utf8_encode_one(cp, buffer));
+        }
+        return res;
+    }
+
+    TEST(utf8, validate) {
+        ASSERT_TRUE(utf8_validate(""));
+        ASSERT_TRUE(utf8_validate("plain ascii"));
+        ASSERT_TRUE(utf8_validate(u8"привет 世界 \U0001F600"));
+        ASSERT_TRUE(utf8_validate("\xF4\x8F\xBF\xBF"));
+        ASSERT_TRUE(utf8_validate("\xED\x9F\xBF"));
+
+        ASSERT_EQ(0, utf8_find_invalid("\x80"));
+        ASSERT_EQ(1, utf8_find_invalid("a\xC0\x80"));          // overlong
+        ASSERT_EQ(0, utf8_find_invalid("\xE0\x80\xAF"));       // overlong
+        ASSERT_EQ(0, utf8_find_invalid("\xED\xA0\x80"));       // surrogate
+        ASSERT_EQ(0, utf8_find_invalid("\xF4\x90\x80\x80"));   // past U+10FFFF
+        ASSERT_EQ(0, utf8_find_invalid("\xF8\x88\x80\x80\x80"));
+        ASSERT_EQ(2, utf8_find_invalid("ab\xE2\x82"));         // truncated
+        ASSERT_EQ(3, utf8_find_invalid("abc\xC3"));
+
+        // errors on and around every block boundary
+        for(size_t at = 0; at < 100; ++at) {
+            for(auto bad : { "\x80", "\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xFF", "\xC3\xC3" }) {
+                std::string s(at, 'a');
+                s += bad;
+                ASSERT_EQ(at, utf8_find_invalid(s)) << at;
+                s += std::string(70, 'b');
+                ASSERT_EQ(at, utf8_find_invalid(s)) << at;
+            }
+            auto s = std::string(at, 'a') + "\xF0\x9F\x98\x80\x80" + std::string(40, 'c');
+            ASSERT_EQ(at + 4, utf8_find_invalid(s)) << at;
+        }
+    }
+
+    TEST(utf8, validate_random) {
+        std::mt19937 rng(5);
+        for(int i = 0; i < 2000; ++i) {
+            auto s = random_utf8(rng, rng() % 200);
+            ASSERT_TRUE(utf8_validate(s));
+            if(s.empty()) continue;
+            for(int k = int(rng() % 3); k >= 0; --k) s[rng() % s.size()] = char(rng());
+            ASSERT_EQ(scalar_invalid(s), utf8_find_invalid(s)) << i;
+        }
+    }
+
+    TEST(utf8, length) {
+        std::mt19937 rng(6);
+        for(int i = 0; i < 500; ++i) {
+            auto count = rng() % 300;
+            auto s = random_utf8(rng, count);
+            ASSERT_EQ(count, utf8_length(s));
+            std::vector<char16_t> utf16(s.size());
+            auto r = utf8_to_utf16(s, utf16.data());
+            ASSERT_TRUE(bool(r));
+            ASSERT_EQ(r.written, utf16_length_from_utf8(s));
+            ASSERT_EQ(s.size(), utf8_length_from_utf16(u16string_view(utf16.data(), r.written)));
+        }
+    }
+
+    TEST(utf8, transcode) {
+        std::mt19937 rng(7);
+        for(int i = 0; i < 500; ++i) {
+            auto s = random_utf8(rng, rng() % 300);
+            std::vector<char32_t> utf32(s.size());
+            auto r32 = utf8_to_utf32(s, utf32.data());
+            ASSERT_TRUE(bool(r32));
+            ASSERT_EQ(s.size(), r32.read);
+            ASSERT_EQ(utf8_length(s), r32.written);
+            std::vector<char16_t> utf16(s.size());
+            auto r16 = utf8_to_utf16(s, utf16.data());
+            ASSERT_TRUE(bool(r16));
+
+            std::string back(s.size(), '\0');
+            auto b32 = utf32_to_utf8(u32string_view(utf32.data(), r32.written), &back[0]);
+            ASSERT_TRUE(bool(b32));
+            ASSERT_EQ(s, back.substr(0, b32.written));
+            auto b16 = utf16_to_utf8(u16string_view(utf16.data(), r16.written), &back[0]);
+            ASSERT_TRUE(bool(b16));
+            ASSERT_EQ(s, back.substr(0, b16.written));
+            ASSERT_EQ(s.size(), utf8_length_from_utf32(u32string_view(utf32.data(), r32.written)));
+        }
+
+        char16_t pair[2];
+        ASSERT_EQ(2, utf8_to_utf16("\xF0\x9F\x98\x80", pair).written);
+        ASSERT_EQ(0xD83D, pair[0]);
+        ASSERT_EQ(0xDE00, pair[1]);
+
+        char32_t out[8];
+        auto bad = utf8_to_utf32("ab\xC3(", out);
+        ASSERT_FALSE(bool(bad));
+        ASSERT_EQ(2, bad.read);
+        ASSERT_EQ(2, bad.written);
+
+        char bytes[16];
+        const char16_t lone[] = { 'a', 0xDC00, 'b' };
+        auto r = utf16_to_utf8(u16string_view(lone, 3), bytes);
+        ASSERT_FALSE(bool(r));
+        ASSERT_EQ(1, r.read);
+        const char32_t big[] = { 0x110000 };
+        ASSERT_FALSE(bool(utf32_to_utf8(u32string_view(big, 1), bytes)));
+
+        wchar_t wide[8];
+        auto w = utf8_to_wide(u8"été", wide);
+        ASSERT_TRUE(bool(w));
+        ASSERT_EQ(wstring_view(L"été"), wstring_view(wide, w.written));
+        auto n = wide_to_utf8(wstring_view(wide, w.written), bytes);
+        ASSERT_EQ(string_view(u8"été"), string_view(bytes, n.written));
+    }
+
+    TEST(utf8, code_points) {
+        std::u32string decoded;
+        string_view text = u8"aé世\U0001F600";
+        for(auto cp : code_points(text)) decoded += cp;
+        ASSERT_EQ(U"aé世\U0001F600", decoded);
+
+        std::vector<size_t> sizes;
+        for(auto it = code_points(text).begin(); it != code_points(text).end(); ++it) sizes.push_back(it.bytes().size());
+        ASSERT_EQ((std::vector<size_t>{ 1, 2, 3, 4 }), sizes);
+
+        decoded.clear();
+        for(auto cp : code_points("x\xC3(\xE2\x82")) decoded += cp;
+        ASSERT_EQ(U"x�(��", decoded);
+        ASSERT_EQ(0, std::distance(code_points("").begin(), code_points("").end()));
+    }
+}
@@ -0,0 +1,144 @@
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "view_flat_map.hpp"
+
+namespace {
+    using namespace essentials;
+
+    TEST(view_flat_map, basic) {
+        view_flat_map<int> map;
+        ASSERT_TRUE(map.empty());
+        ASSERT_TRUE(map.find("x") == map.end());
+
+        ASSERT_TRUE(map.emplace("one", 1).second);
+        ASSERT_FALSE(map.emplace("one", 10).second);
+        map["two"] = 2;
+        map.insert({ "", 0 });
+        ASSERT_EQ(3U, map.size());
+        ASSERT_EQ(1, map.at("one"));
+        ASSERT_EQ(2, map["two"]);
+        ASSERT_EQ(0, map.at(""));
+        ASSERT_THROW(map.at("three"), std::out_of_range);
+
+        map.insert_or_assign("one", 11);
+        ASSERT_EQ(11, map.at("one"));
+        ASSERT_EQ(1U, map.erase("one"));
+        ASSERT_EQ(0U, map.erase("one"));
+        ASSERT_FALSE(map.contains("one"));
+        ASSERT_EQ(2U, map.size());
+    }
+
+    TEST(view_flat_map, heterogeneous) {
+        view_flat_map<int> map{ { "key", 1 }, { "a rather long key that is not inline", 2 } };
+        std::string key = "key", long_key = "a rather long key that is not inline";
+        const char* ptr = "key";
+        ASSERT_EQ(1, map.at(key));
+        ASSERT_EQ(1, map.at(ptr));
+        ASSERT_EQ(2, map.at(long_key));
+        ASSERT_EQ(0U, map.count(std::string("ke")));
+        ASSERT_EQ(0U, map.count("a rather long key that is not inlinE"));
+    }
+
+    TEST(view_flat_map, inline_keys) {
+        // short keys live in the table, the caller's buffer can go away
+        view_flat_map<int> map;
+        {
+            std::string key = "sixteen__bytes!!";
+            map[key] = 16;
+            key = "short";
+            map[key] = 5;
+        }
+        ASSERT_EQ(16, map.at("sixteen__bytes!!"));
+        ASSERT_EQ(5, map.at("short"));
+        // the zero padding is not part of the key
+        ASSERT_FALSE(map.contains(string_view("short\0", 6)));
+        for(auto&& item : map) ASSERT_EQ(item.first.size() == 5? 5 : 16, item.second);
+    }
+
+    TEST(view_flat_map, against_std_map) {
+        std::mt19937 rng{ 42U };
+        std::vector<std::string> keys;
+        for(size_t ix = 0; ix < 5000; ++ix) {
+            std::string key(rng() % 40, 'a');
+            for(auto&& c : key) c = char('a' + rng() % 4);
+            keys.push_back(key);
+        }
+
+        view_flat_map<size_t> map;
+        std::map<std::string, size_t> expected;
+        for(size_t round = 0; round < 20000; ++round) {
+            auto&& key = keys[rng() % keys.size()];
+            switch(rng() % 3) {
+            case 0:
+                map[key] = round;
+                expected[key] = round;
+                break;
+            case 1:
+                ASSERT_EQ(expected.erase(key), map.erase(key));
+                break;
+            default:
+                auto it = map.find(key);
+                auto found = expected.find(key);
+                ASSERT_EQ(found == expected.end(), it == map.end());
+                if(it != map.end()) {
+                    ASSERT_EQ(found->second, it->second);
+                }
+            }
+        }
+        ASSERT_EQ(expected.size(), map.size());
+        size_t count = 0;
+        for(auto&& item : map) {
+            ASSERT_EQ(expected.at(std::string(item.first)), item.second);
+            ++count;
+        }
+        ASSERT_EQ(expected.size(), count);
+    }
+
+    TEST(view_flat_map, values) {
+        // values are moved on rehash and destroyed exactly once
+        auto counter = std::make_shared<int>();
+        {
+            view_flat_map<std::shared_ptr<int>> map;
+            std::vector<std::string> keys;
+            for(int ix = 0; ix < 1000; ++ix) keys.push_back("key " + std::to_string(ix));
+            for(auto&& key : keys) map.emplace(key, counter);
+            ASSERT_EQ(1001, counter.use_count());
+            for(size_t ix = 0; ix < keys.size(); ix += 2) map.erase(keys[ix]);
+            ASSERT_EQ(501, counter.use_count());
+
+            auto copy = map;
+            ASSERT_EQ(1001, counter.use_count());
+            ASSERT_EQ(500U, copy.size());
+            ASSERT_TRUE(copy.contains("key 1"));
+            ASSERT_FALSE(copy.contains("key 0"));
+            copy.clear();
+            ASSERT_EQ(501, counter.use_count());
+        }
+        ASSERT_EQ(1, counter.use_count());
+    }
+
+    TEST(view_flat_map, reserve) {
+        view_flat_map<int> map(1000);
+        auto capacity = map.capacity();
+        ASSERT_LE(1000U, capacity - capacity / 8);
+        std::vector<std::string> keys;
+        for(int ix = 0; ix < 1000; ++ix) keys.push_back(std::to_string(ix));
+        for(auto&& key : keys) map[key] = 1;
+        ASSERT_EQ(capacity, map.capacity());
+        ASSERT_LT(0U, map.memory_usage());
+
+        // erasing and inserting over and over reuses the table
+        for(int round = 0; round < 10; ++round) {
+            for(auto&& key : keys) map.erase(key);
+            for(auto&& key : keys) map[key] = round;
+        }
+        ASSERT_EQ(capacity, map.capacity());
+        ASSERT_EQ(1000U, map.size());
+    }
+}
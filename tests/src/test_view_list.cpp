@@ -0,0 +1,86 @@
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include "view_list.hpp"
+
+namespace {
+    using namespace essentials;
+
+    std::string read_all(int fd) {
+        std::string res;
+        char buffer[4096];
+        ssize_t got;
+        while((got = ::read(fd, buffer, sizeof(buffer))) > 0) res.append(buffer, size_t(got));
+        return res;
+    }
+
+    TEST(view_list, building) {
+        view_list out;
+        std::vector<string_view> headers{ "Host: a", "Accept: */*", "X: y" };
+        out << "HTTP/1.1 200 OK\r\n" << "" << "Server: x\r\n";
+        out.join(headers.begin(), headers.end(), "\r\n");
+        out.append("|").append("ab", 5).append("|").append("ab", 5, view_list::align::left, '.').append("|");
+        out.pad(130, '-');
+        auto expected = "HTTP/1.1 200 OK\r\nServer: x\r\nHost: a\r\nAccept: */*\r\nX: y|   ab|ab...|" + std::string(130, '-');
+        ASSERT_EQ(expected, out.str());
+        ASSERT_EQ(expected.size(), out.size());
+        ASSERT_EQ("Server: x\r\n"_sv, out.piece(1));
+
+        std::vector<char> buffer(out.size());
+        ASSERT_EQ(buffer.data() + buffer.size(), out.copy_to(buffer.data()));
+        ASSERT_EQ(expected, std::string(buffer.begin(), buffer.end()));
+
+        out.clear();
+        ASSERT_TRUE(out.empty());
+        ASSERT_EQ("", out.str());
+    }
+
+    TEST(view_list, padding_matches_streams) {
+        for(size_t width : { 0, 3, 5, 70, 200 }) {
+            std::ostringstream os;
+            os.width(std::streamsize(width));
+            os.fill('*');
+            os << "abcde"_sv;
+            view_list out;
+            out.append("abcde", width, view_list::align::right, '*');
+            ASSERT_EQ(os.str(), out.str());
+        }
+    }
+
+    TEST(view_list, write_and_send) {
+        // more pieces than a single writev takes
+        std::vector<std::string> words;
+        for(int i = 0; i < 5000; ++i) words.push_back(std::to_string(i));
+        view_list out;
+        out.join(words.begin(), words.end(), ",");
+        auto expected = out.str();
+
+        int fds[2];
+        ASSERT_EQ(0, ::pipe(fds));
+        std::string received;
+        std::thread reader([&] { received = read_all(fds[0]); });
+        ASSERT_EQ(expected.size(), out.write_to(fds[1]));
+        ::close(fds[1]);
+        reader.join();
+        ::close(fds[0]);
+        ASSERT_EQ(expected, received);
+
+        int sockets[2];
+        ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+        std::thread receiver([&] { received = read_all(sockets[1]); });
+        ASSERT_EQ(expected.size(), out.send_to(sockets[0]));
+        ::close(sockets[0]);
+        receiver.join();
+        ::close(sockets[1]);
+        ASSERT_EQ(expected, received);
+
+        ASSERT_THROW(out.write_to(-1), std::system_error);
+    }
+
+}
@@ -0,0 +1,434 @@
+#ifndef ESSENTIALS_UTF8_HPP
+#define ESSENTIALS_UTF8_HPP
+
+#include <iterator>
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+struct utf_result {
+    // input code units converted, up to the first invalid sequence if there is one
+    size_t read;
+    // output code units written
+    size_t written;
+    bool valid;
+
+    explicit operator bool() const noexcept { return valid; }
+};
+
+namespace detail {
+
+// the code point starting at `p` and its length in bytes, or 0 for an invalid or truncated sequence
+inline size_t utf8_decode_one(const unsigned char* p, const unsigned char* end, char32_t& cp) noexcept {
+    auto lead = p[0];
+    if(lead < 0x80) {
+        cp = lead;
+        return 1;
+    }
+    // the second byte has a narrower range after some leads: no overlongs, surrogates or values past U+10FFFF
+    unsigned char low = 0x80, high = 0xBF;
+    size_t length;
+    if(lead < 0xC2) return 0;
+    else if(lead < 0xE0) {
+        length = 2;
+        cp = lead & 0x1F;
+    } else if(lead < 0xF0) {
+        length = 3;
+        cp = lead & 0x0F;
+        if(lead == 0xE0) low = 0xA0;
+        else if(lead == 0xED) high = 0x9F;
+    } else if(lead < 0xF5) {
+        length = 4;
+        cp = lead & 0x07;
+        if(lead == 0xF0) low = 0x90;
+        else if(lead == 0xF4) high = 0x8F;
+    } else return 0;
+    if(size_t(end - p) < length || p[1] < low || p[1] > high) return 0;
+    cp = (cp << 6) | (p[1] & 0x3F);
+    for(size_t ix = 2; ix < length; ++ix) {
+        if((p[ix] & 0xC0) != 0x80) return 0;
+        cp = (cp << 6) | (p[ix] & 0x3F);
+    }
+    return length;
+}
+
+inline size_t utf8_encode_one(char32_t cp, char* out) noexcept {
+    if(cp < 0x80) {
+        out[0] = char(cp);
+        return 1;
+    }
+    if(cp < 0x800) {
+        out[0] = char(0xC0 | (cp >> 6));
+        out[1] = char(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if(cp < 0x10000) {
+        out[0] = char(0xE0 | (cp >> 12));
+        out[1] = char(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = char(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = char(0xF0 | (cp >> 18));
+    out[1] = char(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = char(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = char(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+#ifdef ESSENTIALS_SIMD_X86
+__attribute__((target("avx2")))
+inline size_t ascii_prefix_avx2(const unsigned char* p, size_t size) noexcept {
+    size_t ix = 0;
+    for(; ix + 32 <= size; ix += 32) {
+        auto mask = unsigned(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + ix))));
+        if(mask != 0) return ix + size_t(__builtin_ctz(mask));
+    }
+    return ix;
+}
+
+inline size_t ascii_prefix_sse2(const unsigned char* p, size_t size) noexcept {
+    size_t ix = 0;
+    for(; ix + 16 <= size; ix += 16) {
+        auto mask = unsigned(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + ix))));
+        if(mask != 0) return ix + size_t(__builtin_ctz(mask));
+    }
+    return ix;
+}
+
+/*
+ * Keiser-Lemire validation: every byte is classified by its high nibble, the low and high nibbles
+ * of the byte before it and whether the two or three bytes before it started a longer sequence,
+ * three shuffles and a few ands finding every invalid pair at once.
+ */
+__attribute__((target("avx2")))
+inline __m256i utf8_block_errors_avx2(__m256i input, __m256i previous) noexcept {
+    const uint8_t too_short = 1 << 0;  // a lead not followed by a continuation
+    const uint8_t too_long = 1 << 1;   // a continuation after ASCII
+    const uint8_t overlong_3 = 1 << 2;
+    const uint8_t too_large = 1 << 3;
+    const uint8_t surrogate = 1 << 4;
+    const uint8_t overlong_2 = 1 << 5;
+    const uint8_t too_large_1000 = 1 << 6;
+    const uint8_t overlong_4 = 1 << 6;
+    const uint8_t two_continuations = 1 << 7;
+    const uint8_t carry = too_short | too_long | two_continuations;
+
+#define UTF8_TABLE(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+    const auto byte_1_high_table = UTF8_TABLE(
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+        two_continuations, two_continuations, two_continuations, two_continuations,
+        too_short | overlong_2,
+        too_short,
+        too_short | overlong_3 | surrogate,
+        char(too_short | too_large | too_large_1000 | overlong_4));
+    const auto byte_1_low_table = UTF8_TABLE(
+        char(carry | overlong_3 | overlong_2 | overlong_4),
+        char(carry | overlong_2),
+        char(carry), char(carry),
+        char(carry | too_large),
+        char(carry | too_large | too_large_1000), char(carry | too_large | too_large_1000),
+        char(carry | too_large | too_large_1000), char(carry | too_large | too_large_1000),
+        char(carry | too_large | too_large_1000), char(carry | too_large | too_large_1000),
+        char(carry | too_large | too_large_1000), char(carry | too_large | too_large_1000),
+        char(carry | too_large | too_large_1000 | surrogate),
+        char(carry | too_large | too_large_1000), char(carry | too_large | too_large_1000));
+    const auto byte_2_high_table = UTF8_TABLE(
+        too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+        char(too_long | overlong_2 | two_continuations | overlong_3 | too_large_1000 | overlong_4),
+        char(too_long | overlong_2 | two_continuations | overlong_3 | too_large),
+        char(too_long | overlong_2 | two_continuations | surrogate | too_large),
+        char(too_long | overlong_2 | two_continuations | surrogate | too_large),
+        too_short, too_short, too_short, too_short);
+#undef UTF8_TABLE
+
+    // the last bytes of the previous block followed by this one
+    auto joined = _mm256_permute2x128_si256(previous, input, 0x21);
+    auto prev1 = _mm256_alignr_epi8(input, joined, 15);
+    auto prev2 = _mm256_alignr_epi8(input, joined, 14);
+    auto prev3 = _mm256_alignr_epi8(input, joined, 13);
+
+    const auto nibble = _mm256_set1_epi8(0x0F);
+    auto byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    auto byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, nibble));
+    auto byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+    auto special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    // third and fourth bytes have to be continuations, and are the only pairs of continuations allowed
+    auto third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xE0 - 0x80)));
+    auto fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xF0 - 0x80)));
+    auto must_continue = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(char(0x80)));
+    return _mm256_xor_si256(must_continue, special);
+}
+
+// the offset of the 32-byte block an error shows up in, or `size` if there is none
+__attribute__((target("avx2")))
+inline size_t utf8_check_avx2(const unsigned char* p, size_t size) noexcept {
+    // a lead in the last three bytes needs the next block
+    const auto max_value = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+    auto previous = _mm256_setzero_si256(), incomplete = _mm256_setzero_si256();
+    size_t ix = 0;
+    for(; ix < size; ix += 32) {
+        __m256i input;
+        if(ix + 32 <= size) input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + ix));
+        else {
+            // zeros are ASCII, so they end the input cleanly
+            alignas(32) unsigned char tail[32] = {};
+            std::memcpy(tail, p + ix, size - ix);
+            input = _mm256_load_si256(reinterpret_cast<const __m256i*>(tail));
+        }
+        __m256i error;
+        if(_mm256_movemask_epi8(input) == 0) error = incomplete;
+        else {
+            error = utf8_block_errors_avx2(input, previous);
+            incomplete = _mm256_subs_epu8(input, max_value);
+        }
+        if(!_mm256_testz_si256(error, error)) return ix;
+        previous = input;
+    }
+    if(!_mm256_testz_si256(incomplete, incomplete)) return ix - 32;
+    return size;
+}
+
+// code points (non-continuation bytes) and four-byte leads in [p, p + size), a block at a time
+__attribute__((target("avx2")))
+inline size_t utf8_count_avx2(const unsigned char* p, size_t size, size_t& code_points, size_t& four_byte) noexcept {
+    const auto last_continuation = _mm256_set1_epi8(char(0xBF));
+    const auto four_byte_lead = _mm256_set1_epi8(char(0xF0));
+    size_t ix = 0;
+    for(; ix + 32 <= size; ix += 32) {
+        auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + ix));
+        auto starts = _mm256_cmpgt_epi8(input, last_continuation);
+        auto leads = _mm256_cmpeq_epi8(_mm256_max_epu8(input, four_byte_lead), input);
+        code_points += size_t(__builtin_popcount(unsigned(_mm256_movemask_epi8(starts))));
+        four_byte += size_t(__builtin_popcount(unsigned(_mm256_movemask_epi8(leads))));
+    }
+    return ix;
+}
+#endif
+
+// length of the ASCII run at `p`
+inline size_t ascii_prefix(const unsigned char* p, size_t size) noexcept {
+    if(size == 0 || p[0] >= 0x80) return 0;
+    size_t ix = 0;
+#ifdef ESSENTIALS_SIMD_X86
+    ix = cpu::has_avx2()? ascii_prefix_avx2(p, size) : ascii_prefix_sse2(p, size);
+#endif
+    while(ix < size && p[ix] < 0x80) ++ix;
+    return ix;
+}
+
+inline size_t utf8_find_invalid_scalar(const unsigned char* p, size_t size, size_t from) noexcept {
+    for(auto ix = from; ix < size;) {
+        ix += ascii_prefix(p + ix, size - ix);
+        if(ix == size) break;
+        char32_t cp;
+        auto length = utf8_decode_one(p + ix, p + size, cp);
+        if(length == 0) return ix;
+        ix += length;
+    }
+    return size_t(-1);
+}
+
+template<class Unit>
+utf_result utf8_decode(const char* in, size_t size, Unit* out) noexcept {
+    auto first = reinterpret_cast<const unsigned char*>(in), end = first + size, p = first;
+    auto start = out;
+    while(p != end) {
+        auto ascii = ascii_prefix(p, size_t(end - p));
+        for(size_t ix = 0; ix < ascii; ++ix) out[ix] = Unit(p[ix]);
+        p += ascii;
+        out += ascii;
+        if(p == end) break;
+        char32_t cp;
+        auto length = utf8_decode_one(p, end, cp);
+        if(length == 0) return utf_result{ size_t(p - first), size_t(out - start), false };
+        if(sizeof(Unit) == 2 && cp >= 0x10000) {
+            cp -= 0x10000;
+            *out++ = Unit(0xD800 + (cp >> 10));
+            *out++ = Unit(0xDC00 + (cp & 0x3FF));
+        } else *out++ = Unit(cp);
+        p += length;
+    }
+    return utf_result{ size, size_t(out - start), true };
+}
+
+template<class Unit>
+utf_result utf8_encode(const Unit* in, size_t size, char* out) noexcept {
+    auto start = out;
+    size_t ix = 0;
+    while(ix < size) {
+        // ASCII blocks narrow without branches
+        while(size - ix >= 16) {
+            uint64_t any = 0;
+            for(size_t k = 0; k < 16; ++k) any |= code_unit(in[ix + k]);
+            if(any >= 0x80) break;
+            for(size_t k = 0; k < 16; ++k) out[k] = char(in[ix + k]);
+            ix += 16;
+            out += 16;
+        }
+        if(ix == size) break;
+        auto cp = uint32_t(code_unit(in[ix]));
+        size_t length = 1;
+        if(sizeof(Unit) == 2 && cp >= 0xD800 && cp <= 0xDFFF) {
+            auto low = (ix + 1 < size)? uint32_t(code_unit(in[ix + 1])) : 0;
+            if(cp > 0xDBFF || low < 0xDC00 || low > 0xDFFF) return utf_result{ ix, size_t(out - start), false };
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            length = 2;
+        } else if(cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return utf_result{ ix, size_t(out - start), false };
+        out += utf8_encode_one(char32_t(cp), out);
+        ix += length;
+    }
+    return utf_result{ size, size_t(out - start), true };
+}
+
+template<class Unit>
+size_t utf8_length_from(const Unit* in, size_t size) noexcept {
+    size_t res = 0;
+    for(size_t ix = 0; ix < size; ++ix) {
+        auto cp = uint32_t(code_unit(in[ix]));
+        // each half of a surrogate pair is worth two bytes
+        auto surrogate = sizeof(Unit) == 2 && (cp & 0xF800) == 0xD800;
+        res += 1 + (cp >= 0x80) + (cp >= 0x800 && !surrogate) + (cp >= 0x10000);
+    }
+    return res;
+}
+
+} /* namespace detail */
+
+// the offset of the first invalid or truncated sequence, npos for valid UTF-8
+inline size_t utf8_find_invalid(string_view v) noexcept {
+    auto p = reinterpret_cast<const unsigned char*>(v.data());
+    size_t from = 0;
+#ifdef ESSENTIALS_SIMD_X86
+    if(detail::cpu::has_avx2()) {
+        auto block = detail::utf8_check_avx2(p, v.size());
+        if(block == v.size()) return string_view::npos;
+        // the sequence at fault may have started up to three bytes before the block; earlier ones are fine
+        if(block >= 3) {
+            from = block - 3;
+            while(from < block && (p[from] & 0xC0) == 0x80) ++from;
+        }
+    }
+#endif
+    auto res = detail::utf8_find_invalid_scalar(p, v.size(), from);
+    return (res == size_t(-1))? string_view::npos : res;
+}
+
+// well-formed UTF-8: no overlongs, surrogates, values past U+10FFFF or truncated sequences
+inline bool utf8_validate(string_view v) noexcept {
+    return utf8_find_invalid(v) == string_view::npos;
+}
+
+// code points in valid UTF-8
+inline size_t utf8_length(string_view v) noexcept {
+    auto p = reinterpret_cast<const unsigned char*>(v.data());
+    size_t res = 0, four_byte = 0, ix = 0;
+#ifdef ESSENTIALS_SIMD_X86
+    if(detail::cpu::has_avx2()) ix = detail::utf8_count_avx2(p, v.size(), res, four_byte);
+#endif
+    for(; ix < v.size(); ++ix) res += (p[ix] & 0xC0) != 0x80;
+    return res;
+}
+
+// UTF-16 code units valid UTF-8 transcodes to
+inline size_t utf16_length_from_utf8(string_view v) noexcept {
+    auto p = reinterpret_cast<const unsigned char*>(v.data());
+    size_t res = 0, four_byte = 0, ix = 0;
+#ifdef ESSENTIALS_SIMD_X86
+    if(detail::cpu::has_avx2()) ix = detail::utf8_count_avx2(p, v.size(), res, four_byte);
+#endif
+    for(; ix < v.size(); ++ix) {
+        res += (p[ix] & 0xC0) != 0x80;
+        four_byte += p[ix] >= 0xF0;
+    }
+    return res + four_byte;
+}
+
+// bytes valid UTF-16 or UTF-32 transcodes to
+inline size_t utf8_length_from_utf16(u16string_view v) noexcept { return detail::utf8_length_from(v.data(), v.size()); }
+inline size_t utf8_length_from_utf32(u32string_view v) noexcept { return detail::utf8_length_from(v.data(), v.size()); }
+
+/*
+ * Transcoders into caller-provided buffers, validating as they go; they stop at the first invalid sequence.
+ * UTF-16 output needs utf16_length_from_utf8(in) units (in.size() is always enough),
+ * UTF-32 output utf8_length(in) (likewise), UTF-8 output the utf8_length_from_* bytes (3 or 4 per unit at most).
+ * ASCII runs, the common case, are found with SIMD and widened or narrowed a block at a time.
+ */
+inline utf_result utf8_to_utf16(string_view in, char16_t* out) noexcept { return detail::utf8_decode(in.data(), in.size(), out); }
+inline utf_result utf8_to_utf32(string_view in, char32_t* out) noexcept { return detail::utf8_decode(in.data(), in.size(), out); }
+inline utf_result utf16_to_utf8(u16string_view in, char* out) noexcept { return detail::utf8_encode(in.data(), in.size(), out); }
+inline utf_result utf32_to_utf8(u32string_view in, char* out) noexcept { return detail::utf8_encode(in.data(), in.size(), out); }
+
+// wchar_t as UTF-16 or UTF-32, whichever its size is
+inline utf_result utf8_to_wide(string_view in, wchar_t* out) noexcept { return detail::utf8_decode(in.data(), in.size(), out); }
+inline utf_result wide_to_utf8(wstring_view in, char* out) noexcept { return detail::utf8_encode(in.data(), in.size(), out); }
+
+/*
+ * Code points of a UTF-8 view; every byte that does not start a valid sequence comes out as U+FFFD.
+ * base() is the position in the underlying bytes.
+ */
+class utf8_iterator {
+    const unsigned char* p_ = nullptr;
+    const unsigned char* end_ = nullptr;
+    char32_t cp_ = 0;
+    size_t length_ = 0;
+
+    void decode() noexcept {
+        if(p_ == end_) return;
+        length_ = detail::utf8_decode_one(p_, end_, cp_);
+        if(length_ == 0) {
+            cp_ = 0xFFFD;
+            length_ = 1;
+        }
+    }
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = char32_t;
+    using difference_type = ptrdiff_t;
+    using pointer = const char32_t*;
+    using reference = char32_t;
+
+    utf8_iterator() noexcept = default;
+    utf8_iterator(const char* p, const char* end) noexcept:
+        p_(reinterpret_cast<const unsigned char*>(p)), end_(reinterpret_cast<const unsigned char*>(end)) {
+        decode();
+    }
+
+    char32_t operator*() const noexcept { return cp_; }
+    const char* base() const noexcept { return reinterpret_cast<const char*>(p_); }
+    // the bytes of the current code point
+    string_view bytes() const noexcept { return string_view(base(), length_); }
+
+    utf8_iterator& operator++() noexcept {
+        p_ += length_;
+        decode();
+        return *this;
+    }
+    utf8_iterator operator++(int) noexcept {
+        auto copy = *this;
+        ++*this;
+        return copy;
+    }
+
+    friend bool operator==(const utf8_iterator& lhv, const utf8_iterator& rhv) noexcept { return lhv.p_ == rhv.p_; }
+    friend bool operator!=(const utf8_iterator& lhv, const utf8_iterator& rhv) noexcept { return lhv.p_ != rhv.p_; }
+};
+
+class utf8_range {
+    string_view v_;
+
+public:
+    explicit utf8_range(string_view v) noexcept: v_(v) {}
+    utf8_iterator begin() const noexcept { return utf8_iterator(v_.data(), v_.data() + v_.size()); }
+    utf8_iterator end() const noexcept { return utf8_iterator(v_.data() + v_.size(), v_.data() + v_.size()); }
+};
+
+inline utf8_range code_points(string_view v) noexcept { return utf8_range(v); }
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_UTF8_HPP */
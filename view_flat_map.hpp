@@ -0,0 +1,367 @@
+#ifndef ESSENTIALS_VIEW_FLAT_MAP_HPP
+#define ESSENTIALS_VIEW_FLAT_MAP_HPP
+
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+namespace detail {
+
+// a group of 16 control bytes: empty (-128), deleted (-2) or the low 7 hash bits of a full slot
+class control_group {
+    const int8_t* ctrl_;
+
+public:
+    static constexpr int8_t empty = -128;
+    static constexpr int8_t deleted = -2;
+
+    explicit control_group(const int8_t* ctrl) noexcept: ctrl_(ctrl) {}
+
+#ifdef ESSENTIALS_SIMD_X86
+    unsigned match(int8_t tag) const noexcept {
+        auto group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl_));
+        return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(tag))));
+    }
+    unsigned match_empty() const noexcept { return match(empty); }
+    // empty and deleted are the negative ones
+    unsigned match_free() const noexcept {
+        return unsigned(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl_))));
+    }
+#else
+    unsigned match(int8_t tag) const noexcept {
+        unsigned res = 0;
+        for(unsigned ix = 0; ix < 16; ++ix) res |= unsigned(ctrl_[ix] == tag) << ix;
+        return res;
+    }
+    unsigned match_empty() const noexcept { return match(empty); }
+    unsigned match_free() const noexcept {
+        unsigned res = 0;
+        for(unsigned ix = 0; ix < 16; ++ix) res |= unsigned(ctrl_[ix] < 0) << ix;
+        return res;
+    }
+#endif
+};
+
+} /* namespace detail */
+
+/*
+ * Open-addressing (Swiss table) map from string_view to Value.
+ * A 16-byte group of control bytes is scanned with one SSE2 compare for the 7-bit hash fragment;
+ * candidates are then checked against 32 more hash bits and the length kept in the slot,
+ * so the key bytes are only read for a near-certain match.
+ * Keys up to 16 bytes are copied into the slot and compared as two words; longer ones are borrowed
+ * and have to outlive the map, as with unordered_map<string_view, Value>.
+ * Views returned for inline keys point into the table and go stale when it rehashes.
+ * Anything converting to string_view (const char*, std::string) is looked up without a temporary.
+ */
+template<class Value, class Hash = string_view_hash>
+class view_flat_map {
+    static constexpr size_t group_size = 16;
+    static constexpr size_t inline_capacity = 16;
+
+    struct slot {
+        uint32_t tag;
+        uint32_t size;
+        union {
+            const char* data;
+            uint64_t words[2];
+        };
+        alignas(Value) unsigned char storage[sizeof(Value)];
+
+        bool is_inline() const noexcept { return size <= inline_capacity; }
+        const char* key_data() const noexcept { return is_inline()? reinterpret_cast<const char*>(words) : data; }
+        string_view key() const noexcept { return string_view(key_data(), size); }
+        Value& value() noexcept { return *reinterpret_cast<Value*>(storage); }
+        const Value& value() const noexcept { return *reinterpret_cast<const Value*>(storage); }
+    };
+
+    // a key hashed once and, if short, padded into words the way inline slots hold it
+    struct probe_key {
+        string_view key;
+        uint64_t hash;
+        uint64_t words[2];
+
+        probe_key(string_view k, uint64_t h) noexcept: key(k), hash(h), words{ 0, 0 } {
+            if(k.size() <= inline_capacity && !k.empty()) std::memcpy(words, k.data(), k.size());
+        }
+        int8_t control() const noexcept { return int8_t(hash & 0x7F); }
+        uint32_t tag() const noexcept { return uint32_t(hash >> 32); }
+        bool matches(const slot& s) const noexcept {
+            if(s.tag != tag() || s.size != key.size()) return false;
+            if(s.is_inline()) return s.words[0] == words[0] && s.words[1] == words[1];
+            return std::memcmp(s.data, key.data(), key.size()) == 0;
+        }
+    };
+
+    std::unique_ptr<int8_t[]> ctrl_;
+    slot* slots_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    size_t deleted_ = 0;
+    Hash hash_;
+
+    size_t group_mask() const noexcept { return capacity_ / group_size - 1; }
+    size_t growth_limit() const noexcept { return capacity_ - capacity_ / 8; }
+
+    // groups in triangular order, which visits every one of a power-of-two count
+    template<class F>
+    size_t probe(uint64_t hash, F&& visit) const noexcept {
+        auto group = size_t(hash >> 7) & group_mask();
+        for(size_t step = 1;; ++step) {
+            auto res = visit(group * group_size);
+            if(res != npos) return res;
+            group = (group + step) & group_mask();
+        }
+    }
+
+    size_t find_index(const probe_key& k) const noexcept {
+        if(capacity_ == 0) return capacity_;
+        auto res = probe(k.hash, [this, &k](size_t base) {
+            detail::control_group group(ctrl_.get() + base);
+            for(auto mask = group.match(k.control()); mask != 0; mask &= mask - 1) {
+                auto ix = base + size_t(__builtin_ctz(mask));
+                if(k.matches(slots_[ix])) return ix;
+            }
+            return group.match_empty()? capacity_ : npos;
+        });
+        return res;
+    }
+
+    size_t find_free(uint64_t hash) const noexcept {
+        return probe(hash, [this](size_t base) {
+            auto mask = detail::control_group(ctrl_.get() + base).match_free();
+            return (mask != 0)? base + size_t(__builtin_ctz(mask)) : npos;
+        });
+    }
+
+    template<class... Args>
+    size_t insert_new(const probe_key& k, Args&&... args) {
+        if(k.key.size() > UINT32_MAX) throw std::length_error("view_flat_map: key too long");
+        if(size_ + deleted_ + 1 > growth_limit()) rehash((size_ + 1 > growth_limit() / 2)? capacity_ * 2 : capacity_);
+        auto ix = find_free(k.hash);
+        auto&& s = slots_[ix];
+        new(s.storage) Value(std::forward<Args>(args)...);
+        if(ctrl_[ix] == detail::control_group::deleted) --deleted_;
+        ctrl_[ix] = k.control();
+        s.tag = k.tag();
+        s.size = uint32_t(k.key.size());
+        if(s.is_inline()) {
+            s.words[0] = k.words[0];
+            s.words[1] = k.words[1];
+        } else s.data = k.key.data();
+        ++size_;
+        return ix;
+    }
+
+    void rehash(size_t capacity) {
+        if(capacity < group_size) capacity = group_size;
+        std::unique_ptr<int8_t[]> ctrl(new int8_t[capacity]);
+        std::memset(ctrl.get(), detail::control_group::empty, capacity);
+        auto slots = std::allocator<slot>().allocate(capacity);
+
+        auto old_ctrl = std::move(ctrl_);
+        auto old_slots = slots_;
+        auto old_capacity = capacity_;
+        ctrl_ = std::move(ctrl);
+        slots_ = slots;
+        capacity_ = capacity;
+        deleted_ = 0;
+        for(size_t ix = 0; ix < old_capacity; ++ix) {
+            if(old_ctrl[ix] < 0) continue;
+            auto&& from = old_slots[ix];
+            auto to = find_free(hash_(from.key()));
+            ctrl_[to] = old_ctrl[ix];
+            slots_[to].tag = from.tag;
+            slots_[to].size = from.size;
+            slots_[to].words[0] = from.words[0];
+            slots_[to].words[1] = from.words[1];
+            new(slots_[to].storage) Value(std::move(from.value()));
+            from.value().~Value();
+        }
+        if(old_slots) std::allocator<slot>().deallocate(old_slots, old_capacity);
+    }
+
+    void destroy() noexcept {
+        for(size_t ix = 0; ix < capacity_; ++ix)
+            if(ctrl_[ix] >= 0) slots_[ix].value().~Value();
+        if(slots_) std::allocator<slot>().deallocate(slots_, capacity_);
+        slots_ = nullptr;
+        ctrl_.reset();
+        capacity_ = size_ = deleted_ = 0;
+    }
+
+    template<bool Const>
+    class basic_iterator {
+        friend class view_flat_map;
+        template<bool> friend class basic_iterator;
+        using map_type = typename std::conditional<Const, const view_flat_map, view_flat_map>::type;
+        using mapped_reference = typename std::conditional<Const, const Value&, Value&>::type;
+
+        map_type* map_ = nullptr;
+        size_t ix_ = 0;
+
+        basic_iterator(map_type* map, size_t ix) noexcept: map_(map), ix_(ix) { skip(); }
+        void skip() noexcept {
+            while(ix_ < map_->capacity_ && map_->ctrl_[ix_] < 0) ++ix_;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<string_view, Value>;
+        using reference = std::pair<string_view, mapped_reference>;
+        using difference_type = ptrdiff_t;
+
+        struct pointer {
+            reference pair;
+            const reference* operator->() const noexcept { return &pair; }
+        };
+
+        basic_iterator() noexcept = default;
+        // iterator to const_iterator
+        template<bool C = Const, class = typename std::enable_if<C>::type>
+        basic_iterator(const basic_iterator<false>& that) noexcept: map_(that.map_), ix_(that.ix_) {}
+
+        reference operator*() const noexcept {
+            auto&& s = map_->slots_[ix_];
+            return reference(s.key(), s.value());
+        }
+        pointer operator->() const noexcept { return pointer{ **this }; }
+
+        basic_iterator& operator++() noexcept {
+            ++ix_;
+            skip();
+            return *this;
+        }
+        basic_iterator operator++(int) noexcept {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const basic_iterator& lhv, const basic_iterator& rhv) noexcept { return lhv.ix_ == rhv.ix_; }
+        friend bool operator!=(const basic_iterator& lhv, const basic_iterator& rhv) noexcept { return lhv.ix_ != rhv.ix_; }
+    };
+
+public:
+    using key_type = string_view;
+    using mapped_type = Value;
+    using hasher = Hash;
+    using size_type = size_t;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    static constexpr size_t npos = ~size_t(0);
+
+    view_flat_map() = default;
+    explicit view_flat_map(size_t expected, const Hash& hash = Hash()): hash_(hash) { reserve(expected); }
+    view_flat_map(std::initializer_list<std::pair<string_view, Value>> items): view_flat_map(items.size()) {
+        for(auto&& item : items) emplace(item.first, item.second);
+    }
+
+    view_flat_map(const view_flat_map& that): view_flat_map(that.size_, that.hash_) {
+        for(auto&& item : that) emplace(item.first, item.second);
+    }
+    view_flat_map(view_flat_map&& that) noexcept:
+        ctrl_(std::move(that.ctrl_)), slots_(that.slots_), capacity_(that.capacity_),
+        size_(that.size_), deleted_(that.deleted_), hash_(that.hash_) {
+        that.slots_ = nullptr;
+        that.capacity_ = that.size_ = that.deleted_ = 0;
+    }
+    view_flat_map& operator=(view_flat_map that) noexcept {
+        swap(that);
+        return *this;
+    }
+    ~view_flat_map() { destroy(); }
+
+    void swap(view_flat_map& that) noexcept {
+        std::swap(ctrl_, that.ctrl_);
+        std::swap(slots_, that.slots_);
+        std::swap(capacity_, that.capacity_);
+        std::swap(size_, that.size_);
+        std::swap(deleted_, that.deleted_);
+        std::swap(hash_, that.hash_);
+    }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    size_t capacity() const noexcept { return capacity_; }
+    // bytes held by the table
+    size_t memory_usage() const noexcept { return capacity_ * (sizeof(slot) + 1); }
+
+    // room for `count` keys without a rehash
+    void reserve(size_t count) {
+        size_t capacity = group_size;
+        while(capacity - capacity / 8 < count) capacity *= 2;
+        if(capacity > capacity_) rehash(capacity);
+    }
+    void clear() noexcept { destroy(); }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, capacity_); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, capacity_); }
+
+    iterator find(string_view key) noexcept { return iterator(this, find_index(probe_key(key, hash_(key)))); }
+    const_iterator find(string_view key) const noexcept { return const_iterator(this, find_index(probe_key(key, hash_(key)))); }
+    bool contains(string_view key) const noexcept { return find(key) != end(); }
+    size_t count(string_view key) const noexcept { return contains(key)? 1 : 0; }
+
+    Value& at(string_view key) {
+        auto it = find(key);
+        if(it == end()) throw std::out_of_range("view_flat_map: no such key");
+        return (*it).second;
+    }
+    const Value& at(string_view key) const {
+        auto it = find(key);
+        if(it == end()) throw std::out_of_range("view_flat_map: no such key");
+        return (*it).second;
+    }
+
+    // the value is only constructed when `key` is new
+    template<class... Args>
+    std::pair<iterator, bool> emplace(string_view key, Args&&... args) {
+        probe_key k(key, hash_(key));
+        auto ix = find_index(k);
+        if(ix != capacity_) return { iterator(this, ix), false };
+        return { iterator(this, insert_new(k, std::forward<Args>(args)...)), true };
+    }
+    std::pair<iterator, bool> insert(const std::pair<string_view, Value>& item) { return emplace(item.first, item.second); }
+    template<class V>
+    std::pair<iterator, bool> insert_or_assign(string_view key, V&& value) {
+        auto res = emplace(key, std::forward<V>(value));
+        if(!res.second) (*res.first).second = std::forward<V>(value);
+        return res;
+    }
+    Value& operator[](string_view key) { return (*emplace(key).first).second; }
+
+    size_t erase(string_view key) noexcept {
+        auto it = find(key);
+        if(it == end()) return 0;
+        erase(it);
+        return 1;
+    }
+    void erase(const_iterator it) noexcept {
+        auto ix = it.ix_;
+        slots_[ix].value().~Value();
+        // lookups never went past a group that still has an empty slot, so this one can be empty again
+        auto base = ix & ~(group_size - 1);
+        if(detail::control_group(ctrl_.get() + base).match_empty() != 0) ctrl_[ix] = detail::control_group::empty;
+        else {
+            ctrl_[ix] = detail::control_group::deleted;
+            ++deleted_;
+        }
+        --size_;
+    }
+};
+
+template<class Value, class Hash>
+constexpr size_t view_flat_map<Value, Hash>::npos;
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_VIEW_FLAT_MAP_HPP */
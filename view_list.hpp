@@ -0,0 +1,175 @@
+#ifndef ESSENTIALS_VIEW_LIST_HPP
+#define ESSENTIALS_VIEW_LIST_HPP
+
+#include <cerrno>
+#include <climits>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "string_view.hpp"
+
+namespace essentials {
+
+/*
+ * An output assembled from views without copying them: pieces are kept as iovecs
+ * and flushed with writev/sendmsg in batches of at most IOV_MAX, or copied once into a buffer.
+ * Every appended view has to stay alive until the list is flushed or cleared.
+ * Padding points into a static block of fill characters, so it allocates nothing either.
+ */
+class view_list {
+public:
+    enum class align { left, right };
+
+private:
+    std::vector<iovec> pieces_;
+    size_t size_ = 0;
+
+#ifdef IOV_MAX
+    static constexpr size_t batch_limit = IOV_MAX;
+#else
+    static constexpr size_t batch_limit = 1024;
+#endif
+    static constexpr size_t fill_block = 64;
+
+    static const char* fill_chars(char fill) noexcept {
+        static const struct table {
+            char rows[256][fill_block];
+            table() noexcept {
+                for(unsigned c = 0; c < 256; ++c) std::memset(rows[c], int(c), fill_block);
+            }
+        } fills;
+        return fills.rows[static_cast<unsigned char>(fill)];
+    }
+
+    // pushes every piece through `io(iov, count)`, a batch at a time, until everything is out
+    template<class IO>
+    size_t flush_with(IO&& io, const char* what) const {
+        size_t written = 0;
+        std::vector<iovec> batch;
+        for(size_t first = 0; first < pieces_.size();) {
+            auto count = pieces_.size() - first;
+            if(count > batch_limit) count = batch_limit;
+            batch.assign(pieces_.begin() + ptrdiff_t(first), pieces_.begin() + ptrdiff_t(first + count));
+            auto current = batch.data();
+            while(count != 0) {
+                auto res = io(current, int(count));
+                if(res < 0) {
+                    if(errno == EINTR) continue;
+                    throw std::system_error(errno, std::generic_category(), std::string("view_list: ") + what);
+                }
+                written += size_t(res);
+                // skip what is fully written, trim what is partially written
+                auto left = size_t(res);
+                while(count != 0 && left >= current->iov_len) {
+                    left -= current->iov_len;
+                    ++current;
+                    --count;
+                }
+                if(count != 0) {
+                    current->iov_base = static_cast<char*>(current->iov_base) + left;
+                    current->iov_len -= left;
+                }
+            }
+            first += batch.size();
+        }
+        return written;
+    }
+
+public:
+    view_list() = default;
+
+    // total size in bytes
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    size_t pieces() const noexcept { return pieces_.size(); }
+    string_view piece(size_t ix) const noexcept {
+        return string_view(static_cast<const char*>(pieces_[ix].iov_base), pieces_[ix].iov_len);
+    }
+
+    void reserve(size_t pieces) { pieces_.reserve(pieces); }
+    void clear() noexcept {
+        pieces_.clear();
+        size_ = 0;
+    }
+
+    view_list& append(string_view v) {
+        if(v.empty()) return *this;
+        pieces_.push_back(iovec{ const_cast<char*>(v.data()), v.size() });
+        size_ += v.size();
+        return *this;
+    }
+    view_list& operator<<(string_view v) { return append(v); }
+
+    view_list& pad(size_t count, char fill = ' ') {
+        auto block = fill_chars(fill);
+        for(; count > fill_block; count -= fill_block) append(string_view(block, fill_block));
+        return append(string_view(block, count));
+    }
+
+    // `v` padded with `fill` up to `width`, as operator<< on a stream with setw does
+    view_list& append(string_view v, size_t width, align side = align::right, char fill = ' ') {
+        auto padding = (v.size() < width)? width - v.size() : 0;
+        if(side == align::right) pad(padding, fill);
+        append(v);
+        if(side == align::left) pad(padding, fill);
+        return *this;
+    }
+
+    // the views of [first, last) with `separator` between them
+    template<class It>
+    view_list& join(It first, It last, string_view separator) {
+        for(bool head = true; first != last; ++first, head = false) {
+            if(!head) append(separator);
+            append(string_view(*first));
+        }
+        return *this;
+    }
+
+    // copies everything to `out`, which has to hold size() bytes; returns the end of the copy
+    char* copy_to(char* out) const noexcept {
+        for(auto&& p : pieces_) {
+            std::memcpy(out, p.iov_base, p.iov_len);
+            out += p.iov_len;
+        }
+        return out;
+    }
+
+    std::string str() const {
+        std::string res(size_, '\0');
+        copy_to(&res[0]);
+        return res;
+    }
+
+    /*
+     * Writes everything to a blocking descriptor, retrying on EINTR and short writes;
+     * other errors throw std::system_error. Returns the number of bytes written.
+     */
+    size_t write_to(int fd) const {
+        return flush_with([fd](iovec* iov, int count) { return ::writev(fd, iov, count); }, "writev failed");
+    }
+
+    // the same over a connected socket with sendmsg, MSG_NOSIGNAL by default where the platform has it
+#ifdef MSG_NOSIGNAL
+    size_t send_to(int socket, int flags = MSG_NOSIGNAL) const {
+#else
+    size_t send_to(int socket, int flags = 0) const {
+#endif
+        return flush_with([socket, flags](iovec* iov, int count) {
+            msghdr message = {};
+            message.msg_iov = iov;
+            message.msg_iovlen = decltype(message.msg_iovlen)(count);
+            return ::sendmsg(socket, &message, flags);
+        }, "sendmsg failed");
+    }
+};
+
+using iovec_builder = view_list;
+
+} /* namespace essentials */
+
+#endif /* ESSENTIALS_VIEW_LIST_HPP */